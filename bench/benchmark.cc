@@ -0,0 +1,114 @@
+#include "bench/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+#include <fmt/core.h>
+
+#include "logic/utils/color.h"
+#include "logic/utils/mappedFile.h"
+
+using namespace logic;
+
+auto Benchmark::run(std::string_view name, size_t items, const std::function<void()>& body) -> void {
+  if (name.find(mSettings.filter) == std::string_view::npos) return;
+
+  using Clock = std::chrono::steady_clock;
+  const auto time = [&](size_t iterations) {
+    const auto start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      body();
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  };
+
+  // NOTE: the first batch also warms up caches and allocators, it is never measured.
+  size_t iterations = 1;
+  while (time(iterations) < mSettings.batchSeconds and iterations < (size_t(1) << 30)) {
+    iterations *= 2;
+  }
+
+  auto samples = std::vector<double>();
+  for (size_t i = 0; i < mSettings.repetitions; i++) {
+    samples.push_back(time(iterations) / double(iterations));
+  }
+  std::ranges::sort(samples);
+
+  const auto seconds = samples[samples.size() / 2];
+  const auto itemsPerSecond = items == 0 ? 0.0 : double(items) / seconds;
+  mResults.emplace_back(std::string(name), iterations, seconds, itemsPerSecond);
+
+  fmt::println(stderr, "{:<48} {:>12.3f} us {:>14.0f} items/s", name, seconds * 1e6, itemsPerSecond);
+}
+
+auto Benchmark::writeJson(std::FILE* file, const std::vector<Result>& results) -> void {
+  fmt::println(file, "{{");
+  fmt::println(file, "  \"benchmarks\": [");
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& result = results[i];
+    fmt::println(file, "    {{\"name\": \"{}\", \"iterations\": {}, \"seconds\": {:.9e}, \"items_per_second\": {:.6e}}}{}",
+                 result.name, result.iterations, result.seconds, result.itemsPerSecond, i + 1 == results.size() ? "" : ",");
+  }
+  fmt::println(file, "  ]");
+  fmt::println(file, "}}");
+}
+
+auto Benchmark::readJson(std::string_view path) -> std::optional<std::vector<Result>> {
+  auto file = MappedFile::open(path);
+  if (not file) return std::nullopt;
+
+  const auto field = [](std::string_view line, std::string_view key) -> std::optional<std::string_view> {
+    const auto quoted = fmt::format("\"{}\": ", key);
+    const auto start = line.find(quoted);
+    if (start == std::string_view::npos) return std::nullopt;
+
+    auto value = line.substr(start + quoted.size());
+    if (value.starts_with('"')) {
+      return value.substr(1, value.find('"', 1) - 1);
+    }
+    return value.substr(0, value.find_first_of(",}"));
+  };
+
+  auto results = std::vector<Result>();
+  auto contents = file->contents();
+  while (not contents.empty()) {
+    const auto end = std::min(contents.find('\n'), contents.size());
+    const auto line = contents.substr(0, end);
+    contents.remove_prefix(std::min(end + 1, contents.size()));
+
+    const auto name = field(line, "name");
+    const auto seconds = field(line, "seconds");
+    if (not name or not seconds) continue;
+
+    const auto iterations = field(line, "iterations");
+    const auto items = field(line, "items_per_second");
+    results.emplace_back(std::string(*name),
+                         iterations ? std::strtoull(std::string(*iterations).c_str(), nullptr, 10) : 0,
+                         std::strtod(std::string(*seconds).c_str(), nullptr),
+                         items ? std::strtod(std::string(*items).c_str(), nullptr) : 0.0);
+  }
+  return results;
+}
+
+auto Benchmark::compare(const std::vector<Result>& baseline, const std::vector<Result>& current, double threshold) -> size_t {
+  size_t regressions = 0;
+  fmt::println(stderr, "\n{:<48} {:>12} {:>12} {:>9}", "benchmark", "baseline", "current", "change");
+
+  for (const auto& result : current) {
+    const auto previous = std::ranges::find(baseline, result.name, &Result::name);
+    if (previous == baseline.end()) {
+      fmt::println(stderr, "{:<48} {:>12} {:>9.3f} us {:>9}", result.name, "-", result.seconds * 1e6, "new");
+      continue;
+    }
+
+    const auto change = result.seconds / previous->seconds - 1.0;
+    const auto text = fmt::format("{:+8.1f}%", change * 100);
+    const auto regressed = change > threshold;
+    regressions += regressed;
+
+    fmt::println(stderr, "{:<48} {:>9.3f} us {:>9.3f} us {}", result.name, previous->seconds * 1e6, result.seconds * 1e6,
+                 regressed ? fmt::format("{}", Color::Red(text)) : change < -threshold ? fmt::format("{}", Color::Green(text)) : text);
+  }
+  return regressions;
+}
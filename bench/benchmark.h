@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace logic {
+
+// A minimal benchmark runner: every benchmark is a function that is timed in batches until a batch
+// takes long enough to measure, and the median time per iteration over a few batches is reported.
+class Benchmark {
+
+public:
+  struct Result {
+    std::string name;
+    size_t iterations;
+    // the median time of one iteration.
+    double seconds;
+    // what one iteration processes (bytes, rows, ...) per second, zero if it is not meaningful.
+    double itemsPerSecond;
+  };
+
+  struct Settings {
+    std::string filter;
+    double batchSeconds = 0.02;
+    size_t repetitions = 5;
+  };
+
+private:
+  Settings mSettings;
+  std::vector<Result> mResults;
+
+public:
+  explicit Benchmark(Settings settings) : mSettings(std::move(settings)) {}
+
+  // Times `body` unless the name does not contain the filter, `items` is what one call processes.
+  auto run(std::string_view name, size_t items, const std::function<void()>& body) -> void;
+
+  constexpr auto results() const -> const std::vector<Result>& {
+    return mResults;
+  }
+
+  // NOTE: one benchmark per line, so that baselines can be read back without a JSON parser.
+  static auto writeJson(std::FILE*, const std::vector<Result>&) -> void;
+  static auto readJson(std::string_view path) -> std::optional<std::vector<Result>>;
+
+  // Prints the change of every benchmark against the baseline, returns the number of benchmarks that
+  // got slower by more than `threshold` (0.1 is 10%).
+  static auto compare(const std::vector<Result>& baseline, const std::vector<Result>& current, double threshold) -> size_t;
+};
+
+// Keeps the compiler from optimizing away a value that is never read.
+template <typename T>
+inline auto keep(const T& value) -> void {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+}
@@ -0,0 +1,327 @@
+#include <fmt/core.h>
+
+#include <charconv>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/benchmark.h"
+#include "logic/evaluation/evaluator.h"
+#include "logic/parsing/parser.h"
+#include "logic/parsing/scanner.h"
+#include "logic/utils/color.h"
+#include "logic/utils/output.h"
+#include "logic/utils/table.h"
+
+using namespace logic;
+
+// Benchmarks of the scanner, the parser, the evaluator and the printing of tables. The results are
+// written as JSON, and a previous run can be given with `--baseline` to compare against it, in which
+// case the exit code is 2 if any benchmark got slower by more than the threshold.
+
+namespace {
+
+static constexpr auto USAGE = "[--filter=TEXT] [--full] [--repetitions=N] [--out=FILE] [--baseline=FILE] [--threshold=PERCENT]";
+
+struct Arguments {
+  Benchmark::Settings settings;
+  bool full = false;
+  std::string out;
+  std::string baseline;
+  double threshold = 0.1;
+};
+
+auto parseArguments(int argc, const char** argv) -> std::optional<Arguments> {
+  auto arguments = Arguments();
+  for (auto i = 1; i < argc; i++) {
+    auto argument = std::string_view(argv[i]);
+    const auto value = [&](std::string_view flag) -> std::optional<std::string_view> {
+      if (not argument.starts_with(flag) or not argument.substr(flag.size()).starts_with('=')) return std::nullopt;
+      return argument.substr(flag.size() + 1);
+    };
+    const auto number = [](std::string_view text) -> std::optional<size_t> {
+      size_t number = 0;
+      auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number);
+      if (error != std::errc() or end != text.data() + text.size()) return std::nullopt;
+      return number;
+    };
+
+    if (auto filter = value("--filter")) {
+      arguments.settings.filter = *filter;
+    } else if (argument == "--full") {
+      arguments.full = true;
+    } else if (auto repetitions = value("--repetitions"); repetitions and number(*repetitions).value_or(0) > 0) {
+      arguments.settings.repetitions = *number(*repetitions);
+    } else if (auto out = value("--out")) {
+      arguments.out = *out;
+    } else if (auto baseline = value("--baseline")) {
+      arguments.baseline = *baseline;
+    } else if (auto threshold = value("--threshold"); threshold and number(*threshold)) {
+      arguments.threshold = double(*number(*threshold)) / 100;
+    } else {
+      fmt::println(stderr, "{}: unknown option `{}`", Color::Blue("Logic"), argument);
+      return std::nullopt;
+    }
+  }
+  return arguments;
+}
+
+// Sentences are generated from a fixed seed so that every run measures the same inputs.
+class Generator {
+
+private:
+  std::mt19937_64 mRandom = std::mt19937_64(0x10C1C);
+  size_t mNextVariable = 0;
+  size_t mVariables;
+
+public:
+  explicit Generator(size_t variables) : mVariables(variables) {}
+
+  // A sentence with about `connectives` connectives whose leaves cycle through the variables.
+  auto sentence(size_t connectives) -> std::string {
+    static constexpr std::string_view BINARY[] = {"AND", "OR", "IMPLIES", "EQUIVALENT"};
+    if (connectives == 0) {
+      return fmt::format("P{}", mNextVariable++ % mVariables);
+    }
+    if (mRandom() % 5 == 0) {
+      return fmt::format("NOT {}", sentence(connectives - 1));
+    }
+    const auto left = mRandom() % connectives;
+    auto lhs = sentence(left);
+    auto rhs = sentence(connectives - 1 - left);
+    return fmt::format("({} {} {})", lhs, BINARY[mRandom() % 4], rhs);
+  }
+
+  // A sentence nested `depth` parentheses deep, every level adds one connective.
+  auto nested(size_t depth) -> std::string {
+    auto text = std::string(depth, '(');
+    text += fmt::format("P{}", mNextVariable++ % mVariables);
+    for (size_t level = 0; level < depth; level++) {
+      text += fmt::format(" AND P{})", mNextVariable++ % mVariables);
+    }
+    return text;
+  }
+
+  // A sentence nested `depth` levels deep to the right, `NOT (P0 IMPLIES NOT (P1 IMPLIES ...))`,
+  // where every level is a negation, a parenthesis or a connective in turn.
+  auto deep(size_t depth) -> std::string {
+    auto text = std::string();
+    size_t parentheses = 0;
+    for (size_t level = 0; level < depth; level++) {
+      switch (level % 3) {
+        case 0: text += "NOT "; break;
+        case 1: text += '('; parentheses++; break;
+        default: text += fmt::format("P{} IMPLIES ", mNextVariable++ % mVariables); break;
+      }
+    }
+    text += fmt::format("P{}", mNextVariable++ % mVariables);
+    text.append(parentheses, ')');
+    return text;
+  }
+
+  // A single chain of `width` connectives without parentheses, which the precedences nest.
+  auto wide(size_t width) -> std::string {
+    static constexpr std::string_view BINARY[] = {"AND", "OR", "IMPLIES", "EQUIVALENT"};
+    auto text = fmt::format("P{}", mNextVariable++ % mVariables);
+    for (size_t connective = 0; connective < width; connective++) {
+      text += fmt::format(" {} P{}", BINARY[mRandom() % 4], mNextVariable++ % mVariables);
+    }
+    return text;
+  }
+
+  // A rule guarded by the two variables that change slowest, `P0` and `P1` come first in the table,
+  // so three out of four blocks of rows are decided by the guard alone.
+  auto guarded(size_t connectives) -> std::string {
+    return fmt::format("(P0 AND P1) IMPLIES {}", sentence(connectives));
+  }
+
+  auto file(size_t sentences, size_t connectives) -> std::string {
+    auto source = std::string();
+    for (size_t i = 0; i < sentences; i++) {
+      source += sentence(connectives);
+      source += '\n';
+    }
+    return source;
+  }
+};
+
+auto scan(std::string_view source) -> std::vector<Token> {
+  return std::move(*Scanner(source).scan());
+}
+
+// NOTE: tokens and sentences point into the source, which has to outlive them.
+auto parse(std::string_view source) -> std::vector<Sentence> {
+  return std::move(*Parser(scan(source)).parse());
+}
+
+auto runScannerAndParser(Benchmark& benchmark) -> void {
+  for (auto sentences : {100, 10000}) {
+    const auto source = Generator(26).file(sentences, 8);
+    benchmark.run(fmt::format("scan/sentences={}", sentences), source.size(), [&] {
+      keep(scan(source));
+    });
+
+    const auto tokens = scan(source);
+    benchmark.run(fmt::format("parse/sentences={}", sentences), tokens.size(), [&] {
+      keep(Parser(tokens).parse());
+    });
+  }
+
+  for (auto depth : {16, 256, 2048}) {
+    const auto source = Generator(26).nested(depth);
+    const auto tokens = scan(source);
+    benchmark.run(fmt::format("parse/depth={}", depth), tokens.size(), [&] {
+      keep(Parser(tokens).parse());
+    });
+  }
+
+  // NOTE: these are nested far deeper than the call stack would allow a recursive parser to go.
+  for (auto size : {1000, 100000}) {
+    const auto deepSource = Generator(26).deep(size);
+    const auto deep = scan(deepSource);
+    benchmark.run(fmt::format("parse/deep={}", size), deep.size(), [&] {
+      keep(Parser(deep).parse());
+    });
+
+    const auto wideSource = Generator(26).wide(size);
+    const auto wide = scan(wideSource);
+    benchmark.run(fmt::format("parse/wide={}", size), wide.size(), [&] {
+      keep(Parser(wide).parse());
+    });
+  }
+}
+
+auto runEvaluator(Benchmark& benchmark, bool full) -> void {
+  // NOTE: the evaluator echoes every sentence, which is not what is being measured.
+  auto* null = std::fopen("/dev/null", "w");
+  const auto redirect = Output::Redirect(null, null);
+
+  // NOTE: `evaluate` keeps every column of the table in memory, larger tables are only streamed.
+  const auto maxEvaluated = full ? size_t(24) : size_t(20);
+  const auto maxStreamed = full ? size_t(Environment::MAX_VARIABLES) : size_t(24);
+
+  for (size_t variables = 1; variables <= maxStreamed; variables += variables < 4 ? 1 : 4) {
+    const auto source = Generator(variables).sentence(2 * variables);
+    const auto sentences = parse(source);
+    auto environment = Environment();
+    const auto rows = size_t(1) << variables;
+
+    if (variables <= maxEvaluated) {
+      benchmark.run(fmt::format("evaluate/variables={}", variables), rows, [&] {
+        keep(Evaluator(environment).evaluate(sentences.front()));
+      });
+    }
+
+    // the evaluation of `stream` without printing, blocks of rows through a compiled program.
+    benchmark.run(fmt::format("run/variables={}", variables), rows, [&] {
+      auto program = Evaluator(environment).compile(sentences.front(), false);
+      auto machine = Machine();
+      for (size_t start = 0; start < environment.totalRows(); start += Evaluator::BLOCK_ROWS) {
+        machine.run(*program, environment, RowRange(start, std::min(Evaluator::BLOCK_ROWS, environment.totalRows() - start)));
+      }
+      keep(machine);
+    });
+  }
+
+  for (auto variables : {16, 20}) {
+    const auto source = Generator(variables).guarded(4 * variables);
+    const auto sentences = parse(source);
+    auto environment = Environment();
+    benchmark.run(fmt::format("run/guarded/variables={}", variables), size_t(1) << variables, [&] {
+      auto program = Evaluator(environment).compile(sentences.front(), false);
+      auto machine = Machine();
+      for (size_t start = 0; start < environment.totalRows(); start += Evaluator::BLOCK_ROWS) {
+        machine.run(*program, environment, RowRange(start, std::min(Evaluator::BLOCK_ROWS, environment.totalRows() - start)));
+      }
+      keep(machine);
+    });
+  }
+
+  for (auto connectives : {16, 256, 4096}) {
+    const auto source = Generator(12).sentence(connectives);
+    const auto sentences = parse(source);
+    auto environment = Environment();
+    benchmark.run(fmt::format("evaluate/variables=12/connectives={}", connectives), size_t(1) << 12, [&] {
+      keep(Evaluator(environment).evaluate(sentences.front()));
+    });
+  }
+
+  // NOTE: every level of nesting is a column of the table with the whole sentence below it as its name.
+  for (auto depth : {16, 128, 512}) {
+    const auto source = Generator(12).nested(depth);
+    const auto sentences = parse(source);
+    auto environment = Environment();
+    benchmark.run(fmt::format("evaluate/variables=12/depth={}", depth), size_t(1) << 12, [&] {
+      keep(Evaluator(environment).evaluate(sentences.front()));
+    });
+  }
+
+  std::fclose(null);
+}
+
+auto runTable(Benchmark& benchmark) -> void {
+  auto* null = std::fopen("/dev/null", "w");
+  const auto redirect = Output::Redirect(null, null);
+
+  static constexpr std::string_view NAMES[] = {"P0", "P1", "P2", "P3", "P4", "P5", "P6", "P7", "P8", "P9", "P10", "P11",
+                                               "P12", "P13", "P14", "P15", "P0 ∧ P1 ∨ P2 ⇒ P3"};
+
+  for (size_t variables : {4, 8, 12, 16}) {
+    auto environment = Environment();
+    for (size_t i = 0; i < variables; i++) {
+      environment.define(NAMES[i]);
+    }
+
+    auto table = Table();
+    for (size_t i = 0; i < variables; i++) {
+      table.add(Column(NAMES[i], environment.read(NAMES[i])));
+    }
+    table.add(Column(NAMES[16], environment.read(NAMES[0])));
+
+    for (auto format : {StreamingTable::Format::Table, StreamingTable::Format::Csv, StreamingTable::Format::Jsonl, StreamingTable::Format::Bin}) {
+      benchmark.run(fmt::format("print/{}/variables={}", StreamingTable::formatToString(format), variables), environment.totalRows(), [&] {
+        table.print(format);
+      });
+    }
+  }
+
+  std::fclose(null);
+}
+
+}
+
+auto main(int argc, const char** argv) -> int {
+  auto arguments = parseArguments(argc, argv);
+  if (not arguments) {
+    fmt::println(stderr, "{}: usage {}", Color::Blue("Logic"), Color::Yellow(USAGE));
+    return 1;
+  }
+
+  auto benchmark = Benchmark(arguments->settings);
+  runScannerAndParser(benchmark);
+  runEvaluator(benchmark, arguments->full);
+  runTable(benchmark);
+
+  auto* out = arguments->out.empty() ? stdout : std::fopen(arguments->out.c_str(), "w");
+  if (out == nullptr) {
+    fmt::println(stderr, "{}: could not open `{}`", Color::Blue("Logic"), arguments->out);
+    return 1;
+  }
+  Benchmark::writeJson(out, benchmark.results());
+  if (out != stdout) std::fclose(out);
+
+  if (arguments->baseline.empty()) return 0;
+
+  const auto baseline = Benchmark::readJson(arguments->baseline);
+  if (not baseline) {
+    fmt::println(stderr, "{}: could not read the baseline `{}`", Color::Blue("Logic"), arguments->baseline);
+    return 1;
+  }
+  const auto regressions = Benchmark::compare(*baseline, benchmark.results(), arguments->threshold);
+  if (regressions != 0) {
+    fmt::println(stderr, "{} of {} benchmarks are more than {}% slower than the baseline", regressions, benchmark.results().size(), arguments->threshold * 100);
+    return 2;
+  }
+  return 0;
+}
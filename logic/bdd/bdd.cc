@@ -0,0 +1,482 @@
+#include "logic/bdd/bdd.h"
+#include "logic/utils/macros.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+using namespace logic;
+
+namespace {
+
+constexpr size_t INITIAL_BUCKETS = 64;
+constexpr size_t INITIAL_CACHE = 1 << 14;
+constexpr size_t MAX_CACHE = 1 << 22;
+constexpr size_t MIN_REORDER_THRESHOLD = 4096;
+// NOTE: sifting a variable in one direction stops once the diagram is this much larger than the best size seen.
+constexpr double MAX_GROWTH = 1.2;
+
+constexpr uint32_t FREED = UINT32_MAX - 1;
+
+}
+
+Bdd::Bdd(uint32_t variables) {
+  mNodes.push_back(Node(TERMINAL, ONE, ONE, UINT32_MAX, EMPTY));
+  mSubtables.resize(variables);
+  for (auto& subtable : mSubtables) {
+    subtable.buckets.assign(INITIAL_BUCKETS, EMPTY);
+  }
+  mCache.assign(INITIAL_CACHE, CacheEntry(EMPTY, EMPTY, EMPTY, EMPTY));
+
+  for (uint32_t variable = 0; variable < variables; variable++) {
+    mLevelOf.push_back(variable);
+    mVariableAt.push_back(variable);
+  }
+}
+
+auto Bdd::variable(uint32_t variable) -> Edge {
+  return make(variable, ZERO, ONE);
+}
+
+auto Bdd::ref(Edge edge) -> void {
+  auto& node = mNodes[edge >> 1];
+  if ((edge >> 1) == 0) return;
+  if (node.refs == 0) mDead -= 1;
+  node.refs += 1;
+}
+
+auto Bdd::deref(Edge edge) -> void {
+  auto& node = mNodes[edge >> 1];
+  if ((edge >> 1) == 0) return;
+  ASSERT(node.refs > 0, "Dereferenced a dead BDD node");
+  node.refs -= 1;
+  if (node.refs == 0) mDead += 1;
+}
+
+auto Bdd::make(uint32_t variable, Edge low, Edge high) -> Edge {
+  if (low == high) return low;
+
+  // NOTE: the high edge is kept regular, a complemented one is moved to the edge pointing to the node.
+  const auto complement = high & 1;
+  low ^= complement;
+  high ^= complement;
+
+  auto& subtable = mSubtables[variable];
+  const auto bucket = hash(low, high) & (subtable.buckets.size() - 1);
+  for (auto index = subtable.buckets[bucket]; index != EMPTY; index = mNodes[index].next) {
+    const auto& node = mNodes[index];
+    if (node.low == low and node.high == high) {
+      return (index << 1) | complement;
+    }
+  }
+
+  uint32_t index;
+  if (not mFree.empty()) {
+    index = mFree.back();
+    mFree.pop_back();
+    mNodes[index] = Node(variable, low, high, 0, EMPTY);
+  } else {
+    index = mNodes.size();
+    mNodes.emplace_back(variable, low, high, 0, EMPTY);
+  }
+  mDead += 1;
+  ref(low);
+  ref(high);
+  insert(index);
+
+  if (mNodes.size() > 2 * mCache.size() and mCache.size() < MAX_CACHE) {
+    mCache.assign(2 * mCache.size(), CacheEntry(EMPTY, EMPTY, EMPTY, EMPTY));
+  }
+  return (index << 1) | complement;
+}
+
+auto Bdd::insert(uint32_t index) -> void {
+  auto& node = mNodes[index];
+  auto& subtable = mSubtables[node.variable];
+  if (subtable.size + 1 > 2 * subtable.buckets.size()) {
+    grow(subtable);
+  }
+  const auto bucket = hash(node.low, node.high) & (subtable.buckets.size() - 1);
+  node.next = subtable.buckets[bucket];
+  subtable.buckets[bucket] = index;
+  subtable.size += 1;
+}
+
+auto Bdd::remove(uint32_t index) -> void {
+  const auto& node = mNodes[index];
+  auto& subtable = mSubtables[node.variable];
+  auto* link = &subtable.buckets[hash(node.low, node.high) & (subtable.buckets.size() - 1)];
+  while (*link != index) {
+    link = &mNodes[*link].next;
+  }
+  *link = node.next;
+  subtable.size -= 1;
+}
+
+auto Bdd::grow(Subtable& subtable) -> void {
+  auto buckets = std::vector<uint32_t>(2 * subtable.buckets.size(), EMPTY);
+  for (auto head : subtable.buckets) {
+    for (auto index = head; index != EMPTY;) {
+      auto& node = mNodes[index];
+      const auto next = node.next;
+      const auto bucket = hash(node.low, node.high) & (buckets.size() - 1);
+      node.next = buckets[bucket];
+      buckets[bucket] = index;
+      index = next;
+    }
+  }
+  subtable.buckets = std::move(buckets);
+}
+
+// Frees a dead node and every node that dies because of it.
+auto Bdd::release(uint32_t index) -> void {
+  auto pending = std::vector<uint32_t>{index};
+  while (not pending.empty()) {
+    const auto current = pending.back();
+    pending.pop_back();
+
+    remove(current);
+    auto& node = mNodes[current];
+    node.variable = FREED;
+    mFree.push_back(current);
+    mDead -= 1;
+
+    for (auto child : {node.low >> 1, node.high >> 1}) {
+      if (child == 0) continue;
+      auto& refs = mNodes[child].refs;
+      refs -= 1;
+      if (refs == 0) {
+        mDead += 1;
+        pending.push_back(child);
+      }
+    }
+  }
+}
+
+auto Bdd::collect() -> void {
+  if (mDead == 0) return;
+
+  std::vector<uint32_t> dead;
+  for (uint32_t index = 1; index < mNodes.size(); index++) {
+    if (mNodes[index].refs == 0 and mNodes[index].variable != FREED) {
+      dead.push_back(index);
+    }
+  }
+  for (auto index : dead) {
+    release(index);
+  }
+  std::ranges::fill(mCache, CacheEntry(EMPTY, EMPTY, EMPTY, EMPTY));
+}
+
+auto Bdd::checkpoint() -> void {
+  if (mAutoReorder and size() > mReorderThreshold) {
+    reorder();
+    mReorderThreshold = std::max(2 * size(), MIN_REORDER_THRESHOLD);
+    return;
+  }
+  if (mDead > size() and mDead > MIN_REORDER_THRESHOLD) {
+    collect();
+  }
+}
+
+auto Bdd::ite(Edge f, Edge g, Edge h) -> Edge {
+  if (f == ONE) return g;
+  if (f == ZERO) return h;
+
+  if (g == f) g = ONE;
+  else if (g == negation(f)) g = ZERO;
+  if (h == f) h = ZERO;
+  else if (h == negation(f)) h = ONE;
+
+  if (g == h) return g;
+  if (g == ONE and h == ZERO) return f;
+  if (g == ZERO and h == ONE) return negation(f);
+
+  // NOTE: ite(¬f, g, h) = ite(f, h, g) and ite(f, ¬g, ¬h) = ¬ite(f, g, h), so `f` and `g` are made
+  //       regular to share cache entries between equivalent calls.
+  if (f & 1) {
+    f = negation(f);
+    std::swap(g, h);
+  }
+  Edge complement = 0;
+  if (g & 1) {
+    g = negation(g);
+    h = negation(h);
+    complement = 1;
+  }
+
+  auto& entry = mCache[(hash(f, g) ^ (size_t(h) * 0x94D049BB133111EB)) & (mCache.size() - 1)];
+  if (entry.f == f and entry.g == g and entry.h == h) {
+    return entry.result ^ complement;
+  }
+
+  const auto top = std::min({levelOf(f), levelOf(g), levelOf(h)});
+  Edge f0, f1, g0, g1, h0, h1;
+  cofactors(f, top, f0, f1);
+  cofactors(g, top, g0, g1);
+  cofactors(h, top, h0, h1);
+
+  const auto high = ite(f1, g1, h1);
+  const auto low = ite(f0, g0, h0);
+  const auto result = make(mVariableAt[top], low, high);
+
+  // NOTE: `make` may have grown the cache, so the slot is looked up again.
+  mCache[(hash(f, g) ^ (size_t(h) * 0x94D049BB133111EB)) & (mCache.size() - 1)] = CacheEntry(f, g, h, result);
+  return result ^ complement;
+}
+
+auto Bdd::build(const NodeTable& nodes, NodeId root) -> Edge {
+  // NOTE: every node of the table holds one reference to its function until its last parent is built.
+  std::vector<uint32_t> uses(root + 1, 0);
+  std::vector<bool> reachable(root + 1, false);
+  reachable[root] = true;
+  for (auto id = root + 1; id-- > 0;) {
+    if (not reachable[id]) continue;
+    const auto& node = nodes[id];
+    if (node.kind == logic::Node::Kind::Negation or node.isBinary()) {
+      reachable[node.left] = true;
+      uses[node.left] += 1;
+    }
+    if (node.isBinary()) {
+      reachable[node.right] = true;
+      uses[node.right] += 1;
+    }
+  }
+
+  std::vector<Edge> edges(root + 1, ZERO);
+  const auto consume = [&](NodeId id) {
+    if (--uses[id] == 0) deref(edges[id]);
+  };
+
+  for (NodeId id = 0; id <= root; id++) {
+    if (not reachable[id]) continue;
+
+    const auto& node = nodes[id];
+    switch (node.kind) {
+      case logic::Node::Kind::Variable:
+        edges[id] = variable(node.left);
+        break;
+      case logic::Node::Kind::Constant:
+        edges[id] = node.left ? ONE : ZERO;
+        break;
+      case logic::Node::Kind::Negation:
+        edges[id] = negation(edges[node.left]);
+        break;
+      case logic::Node::Kind::Conjunction:
+        edges[id] = conjunction(edges[node.left], edges[node.right]);
+        break;
+      case logic::Node::Kind::Disjunction:
+        edges[id] = disjunction(edges[node.left], edges[node.right]);
+        break;
+      case logic::Node::Kind::Implication:
+        edges[id] = implication(edges[node.left], edges[node.right]);
+        break;
+      case logic::Node::Kind::Bijection:
+        edges[id] = bijection(edges[node.left], edges[node.right]);
+        break;
+    }
+    ref(edges[id]);
+
+    if (node.kind == logic::Node::Kind::Negation or node.isBinary()) consume(node.left);
+    if (node.isBinary()) consume(node.right);
+    checkpoint();
+  }
+
+  return edges[root];
+}
+
+auto Bdd::evaluate(Edge edge, const std::vector<bool>& assignment) const -> bool {
+  while ((edge >> 1) != 0) {
+    const auto& node = nodeOf(edge);
+    edge = (assignment[node.variable] ? node.high : node.low) ^ (edge & 1);
+  }
+  return edge == ONE;
+}
+
+auto Bdd::count(Edge edge) const -> BigInt {
+  auto memo = std::unordered_map<uint32_t, BigInt>();
+  return count(edge, memo) << depthOf(edge);
+}
+
+// The number of assignments of the variables from the level of the edge down that satisfy it.
+auto Bdd::count(Edge edge, std::unordered_map<uint32_t, BigInt>& memo) const -> BigInt {
+  const auto index = edge >> 1;
+  BigInt regular;
+  if (index == 0) {
+    regular = 1;
+  } else if (auto it = memo.find(index); it != memo.end()) {
+    regular = it->second;
+  } else {
+    const auto& node = mNodes[index];
+    const auto level = mLevelOf[node.variable];
+    regular = (count(node.low, memo) << (depthOf(node.low) - level - 1)) +
+              (count(node.high, memo) << (depthOf(node.high) - level - 1));
+    memo.emplace(index, regular);
+  }
+
+  if (edge & 1) {
+    return BigInt::powerOfTwo(mLevelOf.size() - depthOf(edge)) - regular;
+  }
+  return regular;
+}
+
+auto Bdd::satisfy(Edge edge) const -> std::vector<bool> {
+  auto assignment = std::vector<bool>(mLevelOf.size(), false);
+  while ((edge >> 1) != 0) {
+    const auto& node = nodeOf(edge);
+    const auto high = node.high ^ (edge & 1);
+    if (high != ZERO) {
+      assignment[node.variable] = true;
+      edge = high;
+    } else {
+      edge = node.low ^ (edge & 1);
+    }
+  }
+  return assignment;
+}
+
+auto Bdd::size(Edge edge) const -> size_t {
+  std::vector<uint32_t> pending = {edge >> 1};
+  std::vector<bool> visited(mNodes.size(), false);
+  size_t total = 0;
+  while (not pending.empty()) {
+    const auto index = pending.back();
+    pending.pop_back();
+    if (visited[index]) continue;
+    visited[index] = true;
+    total += 1;
+    if (index != 0) {
+      pending.push_back(mNodes[index].low >> 1);
+      pending.push_back(mNodes[index].high >> 1);
+    }
+  }
+  return total;
+}
+
+auto Bdd::reorder() -> void {
+  collect();
+
+  auto variables = mVariableAt;
+  std::ranges::sort(variables, [this](uint32_t a, uint32_t b) {
+    return mSubtables[a].size > mSubtables[b].size;
+  });
+  for (auto variable : variables) {
+    sift(variable);
+  }
+
+  std::ranges::fill(mCache, CacheEntry(EMPTY, EMPTY, EMPTY, EMPTY));
+}
+
+auto Bdd::sift(uint32_t variable) -> void {
+  const auto levels = uint32_t(mVariableAt.size());
+  auto level = mLevelOf[variable];
+  auto best = size();
+  auto bestLevel = level;
+
+  const auto down = [&] {
+    while (level + 1 < levels) {
+      swap(level++);
+      if (size() < best) {
+        best = size();
+        bestLevel = level;
+      }
+      if (double(size()) > MAX_GROWTH * double(best)) break;
+    }
+  };
+  const auto up = [&] {
+    while (level > 0) {
+      swap(--level);
+      if (size() < best) {
+        best = size();
+        bestLevel = level;
+      }
+      if (double(size()) > MAX_GROWTH * double(best)) break;
+    }
+  };
+
+  // NOTE: the closest end is visited first, it needs fewer swaps to get back from.
+  if (level > levels / 2) {
+    down();
+    up();
+  } else {
+    up();
+    down();
+  }
+
+  while (level < bestLevel) swap(level++);
+  while (level > bestLevel) swap(--level);
+}
+
+// Exchanges the variables at `level` and `level + 1` in place: nodes keep their index and their function,
+// so edges held outside the manager stay valid.
+auto Bdd::swap(uint32_t level) -> void {
+  const auto x = mVariableAt[level];
+  const auto y = mVariableAt[level + 1];
+
+  auto& subtable = mSubtables[x];
+  std::vector<uint32_t> nodes;
+  nodes.reserve(subtable.size);
+  for (auto head : subtable.buckets) {
+    for (auto index = head; index != EMPTY; index = mNodes[index].next) {
+      nodes.push_back(index);
+    }
+  }
+  std::ranges::fill(subtable.buckets, EMPTY);
+  subtable.size = 0;
+
+  // NOTE: nodes that do not depend on `y` are reinserted before any new node of `x` is created, so
+  //       that `make` finds them instead of creating duplicates.
+  std::vector<uint32_t> interacting;
+  for (auto index : nodes) {
+    const auto& node = mNodes[index];
+    if (nodeOf(node.low).variable == y or nodeOf(node.high).variable == y) {
+      interacting.push_back(index);
+    } else {
+      insert(index);
+    }
+  }
+
+  std::vector<uint32_t> dead;
+  for (auto index : interacting) {
+    const auto f0 = mNodes[index].low;
+    const auto f1 = mNodes[index].high;
+
+    const auto split = [&](Edge f, Edge& low, Edge& high) {
+      if (nodeOf(f).variable != y) {
+        low = high = f;
+        return;
+      }
+      low = nodeOf(f).low ^ (f & 1);
+      high = nodeOf(f).high ^ (f & 1);
+    };
+    Edge f00, f01, f10, f11;
+    split(f0, f00, f01);
+    split(f1, f10, f11);
+
+    const auto high = make(x, f01, f11);
+    const auto low = make(x, f00, f10);
+    ref(high);
+    ref(low);
+
+    for (auto child : {f0, f1}) {
+      deref(child);
+      if ((child >> 1) != 0 and mNodes[child >> 1].refs == 0) dead.push_back(child >> 1);
+    }
+
+    auto& node = mNodes[index];
+    node.variable = y;
+    node.low = low;
+    node.high = high;
+    insert(index);
+  }
+
+  std::swap(mVariableAt[level], mVariableAt[level + 1]);
+  mLevelOf[x] = level + 1;
+  mLevelOf[y] = level;
+
+  for (auto index : dead) {
+    if (mNodes[index].refs == 0 and mNodes[index].variable != FREED) {
+      release(index);
+    }
+  }
+}
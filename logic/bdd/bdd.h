@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "logic/evaluation/nodeTable.h"
+#include "logic/utils/bigInt.h"
+
+namespace logic {
+
+// A reduced ordered binary decision diagram manager.
+//
+// Functions are edges: the index of a node shifted left once, with the lowest bit marking a complemented
+// edge. The high edge of a node is never complemented, so every function has a single representation
+// and two functions are equivalent iff their edges are equal. Nodes live in one unique table per
+// variable, `ite` results are memoized in a direct-mapped computed table.
+//
+// Nodes are reference counted: the result of an operation is not referenced, so callers must `ref` the
+// edges they keep across a `checkpoint`, which is where garbage is collected and variables reordered.
+class Bdd {
+
+public:
+  using Edge = uint32_t;
+
+  static constexpr Edge ONE = 0;
+  static constexpr Edge ZERO = 1;
+
+  static constexpr auto negation(Edge edge) -> Edge {
+    return edge ^ 1;
+  }
+
+private:
+  struct Node {
+    uint32_t variable;
+    Edge low;
+    Edge high;
+    uint32_t refs;
+    // the next node in the same bucket of the unique table.
+    uint32_t next;
+  };
+
+  struct Subtable {
+    std::vector<uint32_t> buckets;
+    size_t size = 0;
+  };
+
+  struct CacheEntry {
+    Edge f, g, h, result;
+  };
+
+  static constexpr uint32_t TERMINAL = UINT32_MAX;
+  static constexpr uint32_t EMPTY = UINT32_MAX;
+
+  std::vector<Node> mNodes;
+  std::vector<uint32_t> mFree;
+  std::vector<Subtable> mSubtables;
+  std::vector<CacheEntry> mCache;
+
+  std::vector<uint32_t> mLevelOf;
+  std::vector<uint32_t> mVariableAt;
+
+  size_t mDead = 0;
+  size_t mReorderThreshold = 4096;
+  bool mAutoReorder = true;
+
+public:
+  explicit Bdd(uint32_t variables);
+
+  // The function that is true iff the variable is true.
+  auto variable(uint32_t) -> Edge;
+
+  auto ite(Edge f, Edge g, Edge h) -> Edge;
+  auto conjunction(Edge f, Edge g) -> Edge { return ite(f, g, ZERO); }
+  auto disjunction(Edge f, Edge g) -> Edge { return ite(f, ONE, g); }
+  auto implication(Edge f, Edge g) -> Edge { return ite(f, g, ONE); }
+  auto bijection(Edge f, Edge g) -> Edge { return ite(f, g, negation(g)); }
+
+  // Builds the function of a node of the table, the node table variable `i` is the BDD variable `i`.
+  // The result is referenced.
+  auto build(const NodeTable&, NodeId root) -> Edge;
+
+  auto ref(Edge) -> void;
+  auto deref(Edge) -> void;
+
+  // Collects garbage and reorders variables if the diagram grew enough since the last time.
+  auto checkpoint() -> void;
+  auto collect() -> void;
+  // Rudell's sifting: every variable is moved through all levels and left where the diagram is smallest.
+  auto reorder() -> void;
+
+  constexpr auto setAutoReorder(bool value) -> void {
+    mAutoReorder = value;
+  }
+
+  auto evaluate(Edge, const std::vector<bool>& assignment) const -> bool;
+  // Number of assignments of all the variables of the manager that satisfy the function.
+  auto count(Edge) const -> BigInt;
+  // An assignment satisfying the function, variables that do not matter are false.
+  auto satisfy(Edge) const -> std::vector<bool>;
+
+  // Number of live nodes, including the terminal.
+  constexpr auto size() const -> size_t {
+    return mNodes.size() - mFree.size() - mDead;
+  }
+
+  // Number of nodes reachable from the function, including the terminal.
+  auto size(Edge) const -> size_t;
+
+  constexpr auto order() const -> const std::vector<uint32_t>& {
+    return mVariableAt;
+  }
+
+private:
+  auto make(uint32_t variable, Edge low, Edge high) -> Edge;
+  auto insert(uint32_t node) -> void;
+  auto remove(uint32_t node) -> void;
+  auto release(uint32_t node) -> void;
+  auto grow(Subtable&) -> void;
+
+  auto count(Edge, std::unordered_map<uint32_t, BigInt>& memo) const -> BigInt;
+
+  auto swap(uint32_t level) -> void;
+  auto sift(uint32_t variable) -> void;
+
+  constexpr auto nodeOf(Edge edge) const -> const Node& {
+    return mNodes[edge >> 1];
+  }
+
+  constexpr auto levelOf(Edge edge) const -> uint32_t {
+    const auto variable = nodeOf(edge).variable;
+    return variable == TERMINAL ? TERMINAL : mLevelOf[variable];
+  }
+
+  // Like `levelOf` but the terminal is one past the last level.
+  constexpr auto depthOf(Edge edge) const -> size_t {
+    return (edge >> 1) == 0 ? mLevelOf.size() : mLevelOf[nodeOf(edge).variable];
+  }
+
+  // The cofactors of the function with respect to the variable at `level`.
+  constexpr auto cofactors(Edge edge, uint32_t level, Edge& low, Edge& high) const -> void {
+    if (levelOf(edge) != level) {
+      low = high = edge;
+      return;
+    }
+    const auto& node = nodeOf(edge);
+    low = node.low ^ (edge & 1);
+    high = node.high ^ (edge & 1);
+  }
+
+  static constexpr auto hash(Edge low, Edge high) -> size_t {
+    return (size_t(low) * 0x9E3779B97F4A7C15 + high) * 0xBF58476D1CE4E5B9;
+  }
+};
+
+}
@@ -0,0 +1,63 @@
+#include "logic/evaluation/columnCache.h"
+
+using namespace logic;
+
+auto ColumnCache::lookup(Fingerprint fingerprint, RowRange range, Value& into) -> bool {
+  const auto lock = std::scoped_lock(mMutex);
+
+  // NOTE: a hit is trusted without comparing the sub-sentences. Their node ids are only meaningful
+  //       within the `NodeTable` of one program, and the cache is shared by the programs of every
+  //       sentence, so only the fingerprints can be compared. Two different sub-sentences would have
+  //       to collide in both 64-bit hashes to return a wrong column, about 2^-128 per pair, which is
+  //       accepted in exchange for not keeping the structure of every cached sub-sentence.
+  const auto found = mIndex.find(Key(fingerprint, range.start, range.rows));
+  if (found == mIndex.end()) {
+    mStatistics.misses++;
+    return false;
+  }
+
+  mStatistics.hits++;
+  mEntries.splice(mEntries.begin(), mEntries, found->second);
+  into.words.assign(found->second->column.words.begin(), found->second->column.words.end());
+  into.size = found->second->column.size;
+  return true;
+}
+
+auto ColumnCache::insert(Fingerprint fingerprint, RowRange range, const Value& column) -> void {
+  const auto entryBytes = column.words.size() * sizeof(Value::Word) + sizeof(Entry);
+  if (entryBytes > mBudget) return;
+
+  const auto lock = std::scoped_lock(mMutex);
+
+  const auto key = Key(fingerprint, range.start, range.rows);
+  if (mIndex.contains(key)) return;
+
+  while (mBytes + entryBytes > mBudget) {
+    const auto& last = mEntries.back();
+    mBytes -= last.column.words.size() * sizeof(Value::Word) + sizeof(Entry);
+    mIndex.erase(last.key);
+    mEntries.pop_back();
+    mStatistics.evictions++;
+  }
+
+  mEntries.emplace_front(key, column);
+  mIndex.emplace(key, mEntries.begin());
+  mBytes += entryBytes;
+}
+
+auto ColumnCache::clear() -> void {
+  const auto lock = std::scoped_lock(mMutex);
+  mEntries.clear();
+  mIndex.clear();
+  mBytes = 0;
+}
+
+auto ColumnCache::statistics() const -> Statistics {
+  const auto lock = std::scoped_lock(mMutex);
+  return mStatistics;
+}
+
+auto ColumnCache::bytes() const -> size_t {
+  const auto lock = std::scoped_lock(mMutex);
+  return mBytes;
+}
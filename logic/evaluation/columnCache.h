@@ -0,0 +1,120 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "logic/evaluation/nodeTable.h"
+#include "logic/evaluation/value.h"
+
+namespace logic {
+
+// A structural fingerprint of a sub-sentence made of two independently seeded 64-bit hashes.
+// Variables are identified by the bit of the row index their column follows and assigned variables
+// by their value, so sub-sentences with equal fingerprints have equal columns whatever their names.
+// Equal fingerprints are taken to mean equal sub-sentences, see `ColumnCache::lookup`.
+struct Fingerprint {
+  uint64_t high = 0;
+  uint64_t low = 0;
+
+  static constexpr auto leaf(Node::Kind kind, uint64_t value) -> Fingerprint {
+    return Fingerprint(hash(0x243F6A8885A308D3, {uint64_t(kind), value}), hash(0x13198A2E03707344, {uint64_t(kind), value}));
+  }
+
+  static constexpr auto node(Node::Kind kind, Fingerprint left) -> Fingerprint {
+    return node(kind, left, Fingerprint(0, 0));
+  }
+
+  // NOTE: the operands of commutative connectives are ordered, so `A AND B` and `B AND A` are the same column.
+  static constexpr auto node(Node::Kind kind, Fingerprint left, Fingerprint right) -> Fingerprint {
+    const auto commutative = kind == Node::Kind::Conjunction or kind == Node::Kind::Disjunction or kind == Node::Kind::Bijection;
+    if (commutative and right < left) std::swap(left, right);
+    const auto words = {uint64_t(kind), left.high, left.low, right.high, right.low};
+    return Fingerprint(hash(0x243F6A8885A308D3, words), hash(0x13198A2E03707344, words));
+  }
+
+  // The fingerprint of a column that is cached together with the columns before it.
+  static constexpr auto group(Fingerprint columns, Fingerprint next) -> Fingerprint {
+    const auto words = {~uint64_t(0), columns.high, columns.low, next.high, next.low};
+    return Fingerprint(hash(0x243F6A8885A308D3, words), hash(0x13198A2E03707344, words));
+  }
+
+  friend constexpr auto operator<=>(const Fingerprint&, const Fingerprint&) = default;
+
+private:
+  static constexpr auto hash(uint64_t seed, std::initializer_list<uint64_t> words) -> uint64_t {
+    // NOTE: the splitmix64 finalizer, applied after folding in every word.
+    for (auto word : words) {
+      seed ^= word + 0x9E3779B97F4A7C15 + (seed << 6) + (seed >> 2);
+      seed ^= seed >> 30;
+      seed *= 0xBF58476D1CE4E5B9;
+      seed ^= seed >> 27;
+      seed *= 0x94D049BB133111EB;
+      seed ^= seed >> 31;
+    }
+    return seed;
+  }
+};
+
+// Keeps the columns of sub-sentences per block of rows across sentences, so a sub-sentence that is
+// shared by many sentences of a file or a REPL session is evaluated once. Once the columns take more
+// than the budget the least recently used ones are evicted.
+//
+// Machines evaluating blocks in parallel share the cache, every access takes a lock.
+class ColumnCache {
+
+public:
+  static constexpr size_t DEFAULT_BUDGET = size_t(64) << 20;
+
+  struct Statistics {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+  };
+
+private:
+  struct Key {
+    Fingerprint fingerprint;
+    size_t start;
+    size_t rows;
+
+    friend constexpr auto operator==(const Key&, const Key&) -> bool = default;
+  };
+
+  struct KeyHash {
+    constexpr auto operator()(const Key& key) const -> size_t {
+      return key.fingerprint.low ^ (key.start * 0x9E3779B97F4A7C15) ^ key.rows;
+    }
+  };
+
+  struct Entry {
+    Key key;
+    Value column;
+  };
+
+  size_t mBudget;
+  size_t mBytes = 0;
+  // the most recently used entry first.
+  std::list<Entry> mEntries;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> mIndex;
+  Statistics mStatistics;
+  mutable std::mutex mMutex;
+
+public:
+  explicit ColumnCache(size_t budget = DEFAULT_BUDGET) : mBudget(budget) {}
+
+  // Copies the column of the sub-sentence over the rows into `into`, returns false if it is not cached.
+  auto lookup(Fingerprint, RowRange, Value& into) -> bool;
+  auto insert(Fingerprint, RowRange, const Value&) -> void;
+  auto clear() -> void;
+
+  auto statistics() const -> Statistics;
+  auto bytes() const -> size_t;
+};
+
+}
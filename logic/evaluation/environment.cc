@@ -4,58 +4,57 @@
 using namespace logic;
 
 auto Environment::define(std::string_view variableName) -> bool {
-  if (mVariables.contains(variableName)) return true;
+  auto it = std::ranges::lower_bound(mVariables, variableName);
+  if (it != mVariables.end() and *it == variableName) return true;
   if (mVariables.size() >= MAX_VARIABLES) {
     return false;
   }
 
-  mVariables.insert(variableName);
-  initializeDefaultValues();
+  mVariables.insert(it, variableName);
   return true;
 }
 
-auto Environment::read(std::string_view variableName) const -> std::vector<bool> {
-  auto variableNameStr = std::string(variableName);
-  if (mAssignedVariables.contains(variableNameStr)) {
-    return createBoolean(mAssignedVariables.at(variableNameStr));
-  }
-
-  ASSERT(mVariables.contains(variableName));
-
-  auto result = std::vector<bool> {};
-
-  auto offset = mVariables.size() - 1;
-  for (const auto& var : mVariables) {
-    if (variableName == var) { break; }
-    offset -= 1;
-  }
-
-  for (const auto& data : mData) {
-    result.push_back(data.test(offset));
-  }
+auto Environment::read(std::string_view variableName) const -> Value {
+  return read(variableName, 0, totalRows());
+}
 
+auto Environment::read(std::string_view variableName, size_t firstRow, size_t rows) const -> Value {
+  auto result = Value();
+  read(variableName, RowRange(firstRow, rows), result);
   return result;
 }
 
-auto Environment::assign(std::string_view variableName, bool value) -> void {
-  if (mVariables.contains(variableName)) {
-    mVariables.erase(variableName);
-    initializeDefaultValues();
+auto Environment::read(std::string_view variableName, RowRange range, Value& result) const -> void {
+  if (auto assigned = mAssignedVariables.find(variableName); assigned != mAssignedVariables.end()) {
+    result.resize(range.rows);
+    result.fill(assigned->second);
+    return;
   }
 
-  mAssignedVariables[std::string(variableName)] = value;
+  auto slot = slotOf(variableName);
+  ASSERT(slot.has_value());
+  read(*slot, range, result);
 }
 
-auto Environment::initializeDefaultValues() -> void {
-  mData.clear();
+auto Environment::read(uint32_t slot, RowRange range, Value& result) const -> void {
+  ASSERT(slot < mVariables.size());
+  ASSERT(range.start + range.rows <= totalRows());
+  result.resize(range.rows);
 
-  for (auto i = (1 << mVariables.size()) - 1; i >= 0; i--) {
-    mData.push_back(i);
+  const auto offset = uint32_t(mVariables.size() - 1 - slot);
+  for (size_t word = 0; word < result.words.size(); word++) {
+    result.words[word] = columnWord(offset, range.start + word * Value::WORD_BITS);
   }
+  result.clearPadding();
+}
+
+auto Environment::assign(std::string_view variableName, bool value) -> void {
+  if (auto it = std::ranges::lower_bound(mVariables, variableName); it != mVariables.end() and *it == variableName) {
+    mVariables.erase(it);
+  }
+  mAssignedVariables.insert_or_assign(std::string(variableName), value);
 }
 
 auto Environment::resetDefaultValues() -> void {
-  mData.clear();
   mVariables.clear();
 }
-
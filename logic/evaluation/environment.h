@@ -1,50 +1,99 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
-#include <bitset>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
-#include <set>
+
+#include "logic/evaluation/value.h"
 
 namespace logic {
 
 class Environment {
 
 public:
-  static constexpr auto MAX_VARIABLES = 16;
+  // NOTE: rows are never materialized all at once, variable columns are generated per block of
+  //       rows so this is only bounded by how long the caller is willing to wait.
+  static constexpr auto MAX_VARIABLES = 32;
+
+  // The 64 rows starting at `firstRow` of the column of the variable whose bit in the row index is
+  // `offset`. Rows count down from all variables being true, so the variable is true whenever that
+  // bit is clear, and the column is 2^offset ones followed by 2^offset zeros, repeated.
+  static constexpr auto columnWord(uint32_t offset, size_t firstRow) -> Value::Word {
+    using Word = Value::Word;
+    constexpr auto patterns = [] {
+      auto patterns = std::array<Word, 6> {};
+      for (size_t offset = 0; offset < patterns.size(); offset++) {
+        for (size_t bit = 0; bit < Value::WORD_BITS; bit++) {
+          patterns[offset] |= Word(not ((bit >> offset) & 1)) << bit;
+        }
+      }
+      return patterns;
+    }();
+
+    // NOTE: short periods divide the word, so any block is the same pattern starting further along.
+    if (offset < patterns.size()) {
+      return std::rotr(patterns[offset], int(firstRow % Value::WORD_BITS));
+    }
+
+    // NOTE: longer periods flip at most once within a word, at the next multiple of 2^offset.
+    const auto first = ((firstRow >> offset) & 1) ? Word(0) : ~Word(0);
+    const auto flip = (((firstRow >> offset) + 1) << offset) - firstRow;
+    if (flip >= Value::WORD_BITS) return first;
+    const auto before = (Word(1) << flip) - 1;
+    return (first & before) | (~first & ~before);
+  }
 
 private:
-  std::vector<std::bitset<MAX_VARIABLES>> mData;
-  std::set<std::string_view> mVariables;
-  std::map<std::string, bool> mAssignedVariables;
+  // NOTE: kept sorted, the position of a variable is its slot and the order of its column in the table.
+  std::vector<std::string_view> mVariables;
+  std::map<std::string, bool, std::less<>> mAssignedVariables;
 
 public:
 
   auto define(std::string_view) -> bool;
   auto assign(std::string_view, bool value) -> void;
 
-  auto read(std::string_view) const -> std::vector<bool>;
+  auto read(std::string_view) const -> Value;
+  auto read(std::string_view, size_t firstRow, size_t rows) const -> Value;
+  auto read(std::string_view, RowRange, Value& into) const -> void;
+  // Generates the column of the defined variable at `slot` a word at a time, for a block starting at any row.
+  auto read(uint32_t slot, RowRange, Value& into) const -> void;
 
   auto resetDefaultValues() -> void;
 
-  auto initializeDefaultValues() -> void;
+  // Slots are dense indices into the defined variables, they only stay valid until the next `define` or `assign`.
+  constexpr auto slotOf(std::string_view variable) const -> std::optional<uint32_t> {
+    auto it = std::ranges::lower_bound(mVariables, variable);
+    if (it == mVariables.end() or *it != variable) return std::nullopt;
+    return uint32_t(it - mVariables.begin());
+  }
 
   constexpr auto isVariableDefined(std::string_view variable) const -> bool {
-    return mVariables.contains(variable);
+    return std::ranges::binary_search(mVariables, variable);
   }
 
   constexpr auto isVariableAssigned(std::string_view variable) const -> bool {
-    return mAssignedVariables.contains(std::string(variable));
+    return mAssignedVariables.contains(variable);
   }
 
-  constexpr auto createBoolean(bool value) const -> std::vector<bool> {
-    auto size = 1 << mVariables.size();
-    std::vector<bool> result(size);
+  constexpr auto createBoolean(bool value) const -> Value {
+    return Value(value, totalRows());
+  }
 
-    for (auto i=0; i< 1 << size; i++) {
-      result[i] = value;
-    }
-    return result;
+  constexpr auto createBoolean(bool value, size_t rows) const -> Value {
+    return Value(value, rows);
+  }
+
+  constexpr auto totalRows() const -> size_t {
+    return size_t(1) << mVariables.size();
   }
 
   constexpr auto totalVariablesDefined() -> size_t {
@@ -54,7 +103,7 @@ public:
     return mAssignedVariables.size();
   }
 
-  constexpr auto definedVariables() const -> const std::set<std::string_view>& {
+  constexpr auto definedVariables() const -> const std::vector<std::string_view>& {
     return mVariables;
   }
 };
@@ -1,190 +1,273 @@
 
 #include "logic/evaluation/evaluator.h"
 #include "logic/evaluation/environment.h"
+#include "logic/evaluation/kernels.h"
 #include "logic/parsing/scanner.h"
 #include "logic/parsing/parser.h"
 
 #include "logic/utils/macros.h"
 #include "logic/utils/overloaded.h"
 #include "logic/utils/color.h"
+#include "logic/utils/output.h"
+#include "logic/utils/profiler.h"
 
+#include <atomic>
+#include <cstdio>
+#include <optional>
 #include <set>
 #include <ranges>
 #include <utility>
 
 using namespace logic;
 
-#define DEFINE_CONNECTIVE_EVALUATION(name, expr)                               \
-  auto name(Value left, Value right) const->Value {                            \
-    static constexpr auto operation = [](bool p, bool q) { return expr; };     \
-    ASSERT(left.data.size() == right.data.size(), "Left: {} Right: {}",        \
-           left.data.size(), right.data.size());                               \
-    std::vector<bool> result(left.data.size());                                \
-    for (int i = 0; i < left.data.size(); i++) {                               \
-      result[i] = operation(left.data[i], right.data[i]);                      \
-    }                                                                          \
-    return result;                                                             \
-  }
+auto Evaluator::compile(const Sentence& sentence, bool recordColumns) -> std::expected<Program, EvaluatorError> {
+  auto span = Profiler::Span(Profiler::Phase::Compile);
+  TRY(initializeVariables(sentence));
+  auto program = Program::compile(sentence, mEnvironment, recordColumns, mCache != nullptr);
+  span.nodes(program.instructions.size());
+  return program;
+}
+
+auto Evaluator::evaluate(const Sentence& sentence) -> std::expected<Value, EvaluatorError> {
+  fmt::println(Output::err(), "{}", Color::Yellow(Sentence::asString(sentence)));
 
-DEFINE_CONNECTIVE_EVALUATION(Evaluator::implication, not p or q);
-DEFINE_CONNECTIVE_EVALUATION(Evaluator::bijection, p == q);
-DEFINE_CONNECTIVE_EVALUATION(Evaluator::conjunction, p and q);
-DEFINE_CONNECTIVE_EVALUATION(Evaluator::disjunction, p or q);
+  const auto program = TRY(compile(sentence));
+  auto machine = Machine();
+  {
+    auto span = Profiler::Span(Profiler::Phase::Evaluate);
+    span.rows(mEnvironment.totalRows());
+    machine.run(program, mEnvironment, RowRange(0, mEnvironment.totalRows()), mCache);
+  }
 
-auto Evaluator::negation(Value v) const -> Value {
-  std::vector<bool> result(v.data.size());
-  for (int i = 0; i < v.data.size(); i++) {
-    result[i] = not v.data[i];
+  for (const auto& output : program.outputs) {
+    mTable.add(Column(output.name, machine.at(output.reg)));
   }
-  return result;
+  return machine.at(program.result);
 }
 
-auto Evaluator::evaluate(const Sentence& sentence) -> std::expected<Value, EvaluatorError> {
-  fmt::println(stderr, "{}", Color::Yellow(Sentence::asString(sentence)));
+auto Evaluator::stream(const Sentence& sentence, std::string_view label) -> std::expected<void, EvaluatorError> {
+  fmt::println(Output::err(), "{}", Color::Yellow(Sentence::asString(sentence)));
 
-  TRY(initializeVariables(sentence));
-  recordEnvironment();
-  return internalEvaluate(sentence);
-}
+  auto program = TRY(compile(sentence));
+  if (not label.empty() and (sentence.is<Sentence::Variable>() or sentence.is<Sentence::Value>())) {
+    program.outputs.emplace_back(std::string(label), program.result);
+  }
+  const auto totalRows = mEnvironment.totalRows();
 
-auto Evaluator::internalEvaluate(const Sentence& sentence) const -> std::expected<Value, EvaluatorError> {
-  using Result = std::expected<Value, EvaluatorError>;
-  return sentence.accept(
-    overloaded {
-      [this, &sentence](const Sentence::Variable& s) -> Result {
-        auto value = mEnvironment.read(s.identifier.lexeme); 
-        recordEvaluation(sentence, value);
-        return value;
-      },
-      [this](const Sentence::Value& s) -> Result {
-        ASSERT(s.value.type == TokenType::True or s.value.type == TokenType::False);
-        return mEnvironment.createBoolean(s.value.type == TokenType::True);
-      },
-      [this](const Sentence::Grouped& s) -> Result {
-        return internalEvaluate(*s.sentence);
-      },
-      [this, &sentence](const Sentence::Negated& s) -> Result {
-        const auto rhs = TRY(internalEvaluate(*s.sentence));
-        const auto result = negation(rhs);
-        recordEvaluation(sentence, result);
-        return result;
-      },
-      [this, &sentence](const Sentence::Compound& s) -> Result {
-        if (s.connective.type == TokenType::Equal) { 
-          // NOTE:
-          //    we can already be sure that this is a valid assignment since that is checked 
-          //    before-hand by 'recordEvaluation'
-          auto result = TRY(internalEvaluate(*s.right));
-          recordEvaluation(*s.left, result);
-          return result;
-        }
+  std::vector<std::string_view> header;
+  for (const auto& output : program.outputs) {
+    header.push_back(output.name);
+  }
+  const auto table = StreamingTable(header, mFormat);
+  table.printHeader(totalRows);
 
-        const auto lhs = TRY(internalEvaluate(*s.left));
-        const auto rhs = TRY(internalEvaluate(*s.right));
-
-        Value result{};
-        switch (s.connective.type) {
-          case TokenType::And: 
-            result = conjunction(lhs, rhs);
-            break;
-          case TokenType::Or: 
-            result = disjunction(lhs, rhs);
-            break;
-          case TokenType::Implies:
-            result = implication(lhs, rhs);
-            break;
-          case TokenType::Equivalent:
-            result = bijection(lhs, rhs);
-            break;
-          default:
-            std::unreachable();
-        }
+  if (mPool != nullptr and totalRows > BLOCK_ROWS) {
+    streamParallel(program, table);
+    table.printFooter();
+    return {};
+  }
+
+  auto machine = Machine();
+  std::vector<const Value*> columns;
+  for (size_t start = 0; start < totalRows; start += BLOCK_ROWS) {
+    const auto rows = std::min(BLOCK_ROWS, totalRows - start);
+    {
+      auto span = Profiler::Span(Profiler::Phase::Evaluate);
+      span.rows(rows);
+      machine.run(program, mEnvironment, RowRange(start, rows), mCache);
+    }
 
-        recordEvaluation(*s.left, lhs);
-        recordEvaluation(*s.right, rhs);
-        recordEvaluation(sentence, result);
-        return result;
-      },
+    auto span = Profiler::Span(Profiler::Phase::Print);
+    span.rows(rows);
+    columns.clear();
+    for (const auto& output : program.outputs) {
+      columns.push_back(&machine.at(output.reg));
     }
-  );
+    table.printRows(columns, rows);
+  }
+
+  table.printFooter();
+  return {};
 }
 
-auto Evaluator::initializeVariables(const Sentence& sentence) -> std::expected<bool, EvaluatorError>{
-  using Result = std::expected<bool, EvaluatorError>;
-  return sentence.accept(overloaded {
-    [this, &sentence](const Sentence::Variable& s) -> Result { 
-      if (mEnvironment.isVariableAssigned(s.identifier.lexeme)) {
-        return true;
-      }
-      if (not mEnvironment.define(s.identifier.lexeme)) {
-        return std::unexpected(EvaluatorError::MaximumVariablesAchieved(sentence.location()));
-      }
-      return true;
-    },
-    [this](const Sentence::Grouped& s) -> Result { 
-      return initializeVariables(*s.sentence);
-    },
-    [this](const Sentence::Negated& s) -> Result {
-      return initializeVariables(*s.sentence);
-    },
-    [this, &sentence](const Sentence::Compound& s) -> Result {  
-      if (s.connective.type == TokenType::Equal) { 
-        const auto isValidAssignment = s.left->is<Sentence::Variable>() and s.right->is<Sentence::Value>();
-        if (not isValidAssignment) {
-          return std::unexpected(EvaluatorError::InvalidAssignment(sentence.location()));
-        }
+auto Evaluator::classify(const Sentence& sentence) -> std::expected<Classification, EvaluatorError> {
+  fmt::println(Output::err(), "{}", Color::Yellow(Sentence::asString(sentence)));
 
-        auto variableName = s.left->unsafeAs<Sentence::Variable>().identifier.lexeme;
-        auto value = s.right->unsafeAs<Sentence::Value>().value.type == TokenType::True;
-        mEnvironment.assign(variableName, value);
-        return true;
-      }
+  // NOTE: only the result is kept, so the program is free to skip operands that a block does not need.
+  const auto program = TRY(compile(sentence, false));
+  const auto totalRows = mEnvironment.totalRows();
 
-      TRY(initializeVariables(*s.left));
-      TRY(initializeVariables(*s.right));
-      return true;
-    },
-    [](const Sentence::Value& s) -> Result {  
-      return true;
-    },
-  });
-}
+  auto machine = Machine();
+  auto model = totalRows;
+  auto counterexample = totalRows;
+  for (size_t start = 0; start < totalRows and (model == totalRows or counterexample == totalRows); start += BLOCK_ROWS) {
+    const auto rows = std::min(BLOCK_ROWS, totalRows - start);
+    auto span = Profiler::Span(Profiler::Phase::Evaluate);
+    span.rows(rows);
+    machine.run(program, mEnvironment, RowRange(start, rows), mCache);
 
-auto Evaluator::printEvaluation() -> void {
-  mTable.print();
+    const auto& result = machine.at(program.result);
+    if (auto row = result.find(true); model == totalRows and row < rows) model = start + row;
+    if (auto row = result.find(false); counterexample == totalRows and row < rows) counterexample = start + row;
+  }
+
+  if (counterexample == totalRows) return Classification(Classification::Kind::Tautology, {}, {});
+  if (model == totalRows) return Classification(Classification::Kind::Contradiction, {}, {});
+  return Classification(Classification::Kind::Contingent, assignmentOf(model), assignmentOf(counterexample));
 }
 
-auto Evaluator::recordEvaluation(const Sentence& sentence, const Value& result) const -> void {
-  if (sentence.is<Sentence::Variable>()) {
-    // skip recording variables if they have "default" values, as this will be recorded by `recordEnvironment`.
-    const auto isVariableAssigned = mEnvironment.isVariableAssigned(sentence.unsafeAs<Sentence::Variable>().identifier.lexeme);
-    if (not isVariableAssigned) return; 
+auto Evaluator::print(const Classification& classification) -> void {
+  const auto kind = Classification::kindToString(classification.kind);
+  switch (classification.kind) {
+    case Classification::Kind::Tautology:
+      fmt::println(Output::out(), "{}", Color::Green(kind));
+      return;
+    case Classification::Kind::Contradiction:
+      fmt::println(Output::out(), "{}", Color::Red(kind));
+      return;
+    case Classification::Kind::Contingent:
+      fmt::println(Output::out(), "{}", Color::Yellow(kind));
+      break;
   }
 
-  if (sentence.is<Sentence::Value>()) return;
-  if (sentence.is<Sentence::Grouped>()) return;
+  const auto format = [](const std::vector<std::pair<std::string_view, bool>>& witness) {
+    std::string assignments;
+    for (const auto& [name, value] : witness) {
+      if (not assignments.empty()) assignments += ", ";
+      assignments += fmt::format("{} = {}", name, value ? "T" : "F");
+    }
+    return assignments;
+  };
+  fmt::println(Output::out(), "{} {}", Color::Gray("model:"), format(classification.model));
+  fmt::println(Output::out(), "{} {}", Color::Gray("counterexample:"), format(classification.counterexample));
+}
 
-  auto stringRep = Sentence::asString(sentence);
-  for (const auto& column : mTable.columns()) {
-    if (column[0] == stringRep) { return; }
+// NOTE: the variable at slot `i` is true whenever bit `n - 1 - i` of the row index is clear, see `Environment::columnWord`.
+auto Evaluator::assignmentOf(size_t row) const -> std::vector<std::pair<std::string_view, bool>> {
+  const auto& variables = mEnvironment.definedVariables();
+  auto assignment = std::vector<std::pair<std::string_view, bool>>();
+  assignment.reserve(variables.size());
+  for (size_t slot = 0; slot < variables.size(); slot++) {
+    assignment.emplace_back(variables[slot], not ((row >> (variables.size() - 1 - slot)) & 1));
   }
+  return assignment;
+}
 
-  Column column(result.data.size());
-  column.add(stringRep);
-  for (const auto& boolean : result.data) {
-    column.add( boolean ? "T" : "F" );
+auto Classification::kindToString(Kind kind) -> std::string_view {
+  switch (kind) {
+    case Kind::Tautology: return "TAUTOLOGY";
+    case Kind::Contradiction: return "CONTRADICTION";
+    case Kind::Contingent: return "CONTINGENT";
   }
-  mTable.add(std::move(column));
+  std::unreachable();
 }
 
-auto Evaluator::recordEnvironment() const -> void {
-  for (const auto& variable : mEnvironment.definedVariables()) {
-    Column column(variable.size() + 1);
-    column.add(variable);
-    for (const auto& boolean : mEnvironment.read(variable)) {
-      column.add( boolean ? "T" : "F" );
+auto Evaluator::streamParallel(const Program& program, const StreamingTable& table) -> void {
+  struct Slot {
+    Machine machine;
+    std::vector<const Value*> columns;
+    std::string text;
+    std::atomic<bool> ready = false;
+  };
+
+  const auto totalRows = mEnvironment.totalRows();
+  const auto blocks = (totalRows + BLOCK_ROWS - 1) / BLOCK_ROWS;
+
+  // NOTE: only a window of blocks is in flight at once, so memory stays bounded while the
+  //       workers run ahead of the thread that prints the blocks in order.
+  const auto window = std::min<size_t>(2 * mPool->size(), blocks);
+  auto slots = std::vector<Slot>(window);
+
+  const auto schedule = [&](size_t block) {
+    auto& slot = slots[block % window];
+    slot.ready = false;
+    mPool->submit([&, block] {
+      const auto start = block * BLOCK_ROWS;
+      const auto rows = std::min(BLOCK_ROWS, totalRows - start);
+      {
+        auto span = Profiler::Span(Profiler::Phase::Evaluate);
+        span.rows(rows);
+        slot.machine.run(program, mEnvironment, RowRange(start, rows), mCache);
+      }
+
+      {
+        auto span = Profiler::Span(Profiler::Phase::Print);
+        span.rows(rows);
+        slot.columns.clear();
+        for (const auto& output : program.outputs) {
+          slot.columns.push_back(&slot.machine.at(output.reg));
+        }
+        slot.text.clear();
+        table.renderRows(slot.columns, 0, rows, slot.text);
+      }
+
+      slot.ready = true;
+      slot.ready.notify_one();
+    });
+  };
+
+  for (size_t block = 0; block < window; block++) {
+    schedule(block);
+  }
+
+  for (size_t block = 0; block < blocks; block++) {
+    auto& slot = slots[block % window];
+    slot.ready.wait(false);
+    {
+      // NOTE: the rows were counted by the worker that rendered them.
+      auto span = Profiler::Span(Profiler::Phase::Print);
+      std::fwrite(slot.text.data(), 1, slot.text.size(), Output::out());
+    }
+
+    if (block + window < blocks) {
+      schedule(block + window);
     }
-    mTable.add(std::move(column));
   }
 }
 
+auto Evaluator::declare(const Sentence& sentence) -> std::expected<void, EvaluatorError> {
+  TRY(initializeVariables(sentence));
+  return {};
+}
+
+auto Evaluator::initializeVariables(const Sentence& sentence) -> std::expected<bool, EvaluatorError>{
+  auto error = std::optional<EvaluatorError>();
+
+  // NOTE: the sentences are checked on the way down, so the first error is the leftmost one.
+  const auto enter = [this, &error](const Sentence& sentence) -> bool {
+    if (error.has_value()) return false;
+
+    if (sentence.is<Sentence::Variable>()) {
+      const auto name = sentence.unsafeAsRef<Sentence::Variable>().identifier.lexeme;
+      if (not mEnvironment.isVariableAssigned(name) and not mEnvironment.define(name)) {
+        error = EvaluatorError::MaximumVariablesAchieved(sentence.location());
+      }
+      return false;
+    }
+
+    if (not sentence.is<Sentence::Compound>()) return true;
+    const auto& s = sentence.unsafeAsRef<Sentence::Compound>();
+    if (s.connective.type != TokenType::Equal) return true;
+
+    const auto isValidAssignment = s.left->is<Sentence::Variable>() and s.right->is<Sentence::Value>();
+    if (not isValidAssignment) {
+      error = EvaluatorError::InvalidAssignment(sentence.location());
+      return false;
+    }
+
+    auto variableName = s.left->unsafeAs<Sentence::Variable>().identifier.lexeme;
+    auto value = s.right->unsafeAs<Sentence::Value>().value.type == TokenType::True;
+    mEnvironment.assign(variableName, value);
+    return false;
+  };
+
+  Sentence::walk(sentence, enter, [](const Sentence&) {});
+  if (error.has_value()) return std::unexpected(*error);
+  return true;
+}
+
+auto Evaluator::printEvaluation() -> void {
+  auto span = Profiler::Span(Profiler::Phase::Print);
+  span.rows(mEnvironment.totalRows());
+  mTable.print(mFormat);
+}
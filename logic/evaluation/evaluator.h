@@ -2,12 +2,16 @@
 
 #include "logic/evaluation/value.h"
 #include "logic/parsing/sentence.h"
+#include "logic/evaluation/columnCache.h"
 #include "logic/evaluation/environment.h"
+#include "logic/evaluation/program.h"
 
 #include "logic/utils/macros.h"
 #include "logic/utils/table.h"
+#include "logic/utils/threadPool.h"
 
 #include <string_view>
+#include <utility>
 #include <vector>
 #include <cstddef>
 #include <expected>
@@ -41,31 +45,66 @@ public:
   } 
 };
 
+// Whether a sentence is true on every row of its truth table, on none of them or only on some. A
+// contingent sentence comes with the first row where it is true and the first where it is false.
+struct Classification {
+  enum class Kind : uint8_t {
+    Tautology,
+    Contradiction,
+    Contingent,
+  };
+
+  Kind kind;
+  std::vector<std::pair<std::string_view, bool>> model;
+  std::vector<std::pair<std::string_view, bool>> counterexample;
+
+  static auto kindToString(Kind) -> std::string_view;
+};
+
 class Evaluator {
 
+public:
+  // Number of rows evaluated at once by `stream`, each register of a block takes 1 KiB.
+  static constexpr size_t BLOCK_ROWS = 1 << 13;
+
 private:
   Environment& mEnvironment;
-  mutable Table mTable;
+  ThreadPool* mPool;
+  StreamingTable::Format mFormat;
+  ColumnCache* mCache;
+  Table mTable;
 
 private:
   auto initializeVariables(const Sentence&) -> std::expected<bool, EvaluatorError>;
-  auto internalEvaluate(const Sentence&) const -> std::expected<Value, EvaluatorError>;
-
-  auto recordEvaluation(const Sentence&, const Value&) const -> void;
-  auto recordEnvironment() const -> void;
-
-  auto negation(Value) const -> Value;
-  auto conjunction(Value, Value) const -> Value;
-  auto disjunction(Value, Value) const -> Value;
-  auto implication(Value, Value) const -> Value;
-  auto bijection(Value, Value) const -> Value;
+  auto assignmentOf(size_t row) const -> std::vector<std::pair<std::string_view, bool>>;
+  auto streamParallel(const Program&, const StreamingTable&) -> void;
 
 public:
-  Evaluator(Environment& env) : mEnvironment(env) {
+  // NOTE: the cache outlives the evaluator, so sub-sentences shared by consecutive sentences are evaluated once.
+  Evaluator(Environment& env, ThreadPool* pool = nullptr, StreamingTable::Format format = StreamingTable::Format::Table,
+            ColumnCache* cache = nullptr)
+    : mEnvironment(env), mPool(pool), mFormat(format), mCache(cache) {
     env.resetDefaultValues();
   }
   auto evaluate(const Sentence&) -> std::expected<Value, EvaluatorError>;
 
+  // Evaluates and prints the truth table block by block, so memory does not grow with the number of rows.
+  // With a thread pool the blocks are evaluated concurrently and printed in row order. A sentence that
+  // is a single variable or constant has no column of its own, with a `label` its result is shown under it.
+  auto stream(const Sentence&, std::string_view label = {}) -> std::expected<void, EvaluatorError>;
+
+  // Evaluates the sentence block by block without building any column of its table, and stops as soon
+  // as it has been true on one row and false on another.
+  auto classify(const Sentence&) -> std::expected<Classification, EvaluatorError>;
+  static auto print(const Classification&) -> void;
+
+  // Defines the variables of a sentence without evaluating it, so that a simplified form of the
+  // sentence still gets a row for every assignment of the variables of the original one.
+  auto declare(const Sentence&) -> std::expected<void, EvaluatorError>;
+
+  // Checks the sentence against the environment and lowers it into a program that can be run many times.
+  auto compile(const Sentence&, bool recordColumns = true) -> std::expected<Program, EvaluatorError>;
+
   auto printEvaluation() -> void;
 };
 
@@ -0,0 +1,280 @@
+#include "logic/evaluation/kernels.h"
+#include "logic/utils/macros.h"
+
+#include <bit>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LOGIC_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+using namespace logic;
+using Word = Kernels::Word;
+
+namespace {
+
+// NOTE: `p` and `q` are whole words, the callers are responsible for clearing the bits past the
+//       last row since negation, implication and bijection set them.
+#define DEFINE_SCALAR_KERNEL(name, expr)                                       \
+  auto name(Word* out, const Word* lhs, const Word* rhs, size_t words)->void { \
+    for (size_t i = 0; i < words; i++) {                                       \
+      const auto p = lhs[i];                                                   \
+      const auto q = rhs[i];                                                   \
+      out[i] = expr;                                                           \
+    }                                                                          \
+  }
+
+DEFINE_SCALAR_KERNEL(conjunctionScalar, p & q);
+DEFINE_SCALAR_KERNEL(disjunctionScalar, p | q);
+DEFINE_SCALAR_KERNEL(implicationScalar, ~p | q);
+DEFINE_SCALAR_KERNEL(bijectionScalar, ~(p ^ q));
+
+auto negationScalar(Word* out, const Word* in, size_t words) -> void {
+  for (size_t i = 0; i < words; i++) {
+    out[i] = ~in[i];
+  }
+}
+
+auto popcountScalar(const Word* in, size_t words) -> size_t {
+  size_t total = 0;
+  for (size_t i = 0; i < words; i++) {
+    total += std::popcount(in[i]);
+  }
+  return total;
+}
+
+#ifdef LOGIC_X86_KERNELS
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#define TARGET_AVX512_POPCNT __attribute__((target("avx512f,avx512vpopcntdq")))
+#define TARGET_POPCNT __attribute__((target("popcnt")))
+
+TARGET_POPCNT auto popcountHardware(const Word* in, size_t words) -> size_t {
+  size_t total = 0;
+  for (size_t i = 0; i < words; i++) {
+    total += __builtin_popcountll(in[i]);
+  }
+  return total;
+}
+
+// 4 words per 256-bit lane, the remaining words go through the scalar expression.
+#define DEFINE_AVX2_KERNEL(name, vectorExpr, scalarExpr)                       \
+  TARGET_AVX2 auto name(Word* out, const Word* lhs, const Word* rhs,          \
+                        size_t words)->void {                                  \
+    const auto ones = _mm256_set1_epi64x(-1);                                  \
+    (void)ones;                                                                \
+    size_t i = 0;                                                              \
+    for (; i + 4 <= words; i += 4) {                                           \
+      const auto p = _mm256_loadu_si256((const __m256i*)(lhs + i));            \
+      const auto q = _mm256_loadu_si256((const __m256i*)(rhs + i));            \
+      _mm256_storeu_si256((__m256i*)(out + i), vectorExpr);                    \
+    }                                                                          \
+    for (; i < words; i++) {                                                   \
+      const auto p = lhs[i];                                                   \
+      const auto q = rhs[i];                                                   \
+      out[i] = scalarExpr;                                                     \
+    }                                                                          \
+  }
+
+DEFINE_AVX2_KERNEL(conjunctionAVX2, _mm256_and_si256(p, q), p & q);
+DEFINE_AVX2_KERNEL(disjunctionAVX2, _mm256_or_si256(p, q), p | q);
+DEFINE_AVX2_KERNEL(implicationAVX2, _mm256_or_si256(_mm256_xor_si256(p, ones), q), ~p | q);
+DEFINE_AVX2_KERNEL(bijectionAVX2, _mm256_xor_si256(_mm256_xor_si256(p, q), ones), ~(p ^ q));
+
+TARGET_AVX2 auto negationAVX2(Word* out, const Word* in, size_t words) -> void {
+  const auto ones = _mm256_set1_epi64x(-1);
+  size_t i = 0;
+  for (; i + 4 <= words; i += 4) {
+    const auto p = _mm256_loadu_si256((const __m256i*)(in + i));
+    _mm256_storeu_si256((__m256i*)(out + i), _mm256_xor_si256(p, ones));
+  }
+  for (; i < words; i++) {
+    out[i] = ~in[i];
+  }
+}
+
+// Nibble lookup population count (Muła et al.), accumulated with `vpsadbw` into 64-bit lanes.
+TARGET_AVX2 TARGET_POPCNT auto popcountAVX2(const Word* in, size_t words) -> size_t {
+  const auto lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                       0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const auto lowMask = _mm256_set1_epi8(0x0f);
+  auto accumulator = _mm256_setzero_si256();
+
+  size_t i = 0;
+  for (; i + 4 <= words; i += 4) {
+    const auto v = _mm256_loadu_si256((const __m256i*)(in + i));
+    const auto low = _mm256_and_si256(v, lowMask);
+    const auto high = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+    const auto counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+    accumulator = _mm256_add_epi64(accumulator, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+  }
+
+  size_t total = _mm256_extract_epi64(accumulator, 0) + _mm256_extract_epi64(accumulator, 1) +
+                 _mm256_extract_epi64(accumulator, 2) + _mm256_extract_epi64(accumulator, 3);
+  for (; i < words; i++) {
+    total += __builtin_popcountll(in[i]);
+  }
+  return total;
+}
+
+// 8 words per 512-bit lane, the tail is handled with a masked load/store instead of a scalar loop.
+// The immediates are the truth tables of `vpternlogq` where `p` is the first operand.
+#define DEFINE_AVX512_KERNEL(name, immediate)                                  \
+  TARGET_AVX512 auto name(Word* out, const Word* lhs, const Word* rhs,        \
+                          size_t words)->void {                                \
+    size_t i = 0;                                                              \
+    for (; i + 8 <= words; i += 8) {                                           \
+      const auto p = _mm512_loadu_si512(lhs + i);                              \
+      const auto q = _mm512_loadu_si512(rhs + i);                              \
+      _mm512_storeu_si512(out + i, _mm512_ternarylogic_epi64(p, q, q, immediate)); \
+    }                                                                          \
+    if (i < words) {                                                           \
+      const auto mask = __mmask8((1u << (words - i)) - 1);                     \
+      const auto p = _mm512_maskz_loadu_epi64(mask, lhs + i);                  \
+      const auto q = _mm512_maskz_loadu_epi64(mask, rhs + i);                  \
+      _mm512_mask_storeu_epi64(out + i, mask, _mm512_ternarylogic_epi64(p, q, q, immediate)); \
+    }                                                                          \
+  }
+
+DEFINE_AVX512_KERNEL(conjunctionAVX512, 0xC0);
+DEFINE_AVX512_KERNEL(disjunctionAVX512, 0xFC);
+DEFINE_AVX512_KERNEL(implicationAVX512, 0xCF);
+DEFINE_AVX512_KERNEL(bijectionAVX512, 0xC3);
+
+TARGET_AVX512 auto negationAVX512(Word* out, const Word* in, size_t words) -> void {
+  size_t i = 0;
+  for (; i + 8 <= words; i += 8) {
+    const auto p = _mm512_loadu_si512(in + i);
+    _mm512_storeu_si512(out + i, _mm512_ternarylogic_epi64(p, p, p, 0x0F));
+  }
+  if (i < words) {
+    const auto mask = __mmask8((1u << (words - i)) - 1);
+    const auto p = _mm512_maskz_loadu_epi64(mask, in + i);
+    _mm512_mask_storeu_epi64(out + i, mask, _mm512_ternarylogic_epi64(p, p, p, 0x0F));
+  }
+}
+
+TARGET_AVX512_POPCNT auto popcountAVX512(const Word* in, size_t words) -> size_t {
+  auto accumulator = _mm512_setzero_si512();
+  size_t i = 0;
+  for (; i + 8 <= words; i += 8) {
+    accumulator = _mm512_add_epi64(accumulator, _mm512_popcnt_epi64(_mm512_loadu_si512(in + i)));
+  }
+  if (i < words) {
+    const auto mask = __mmask8((1u << (words - i)) - 1);
+    accumulator = _mm512_add_epi64(accumulator, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(mask, in + i)));
+  }
+  // NOTE: `_mm512_reduce_add_epi64` and the unmasked extracts merge into an undefined vector, which GCC
+  //       warns about, so the halves are extracted into zeroes and the lanes added by hand.
+  const auto sum = _mm256_add_epi64(_mm512_maskz_extracti64x4_epi64(0xF, accumulator, 0),
+                                    _mm512_maskz_extracti64x4_epi64(0xF, accumulator, 1));
+  return _mm256_extract_epi64(sum, 0) + _mm256_extract_epi64(sum, 1) + _mm256_extract_epi64(sum, 2) + _mm256_extract_epi64(sum, 3);
+}
+
+#endif
+
+}
+
+auto Kernels::isSupported(Level level) -> bool {
+  switch (level) {
+    case Level::Scalar:
+      return true;
+#ifdef LOGIC_X86_KERNELS
+    case Level::AVX2:
+      return __builtin_cpu_supports("avx2");
+    case Level::AVX512:
+      return __builtin_cpu_supports("avx512f");
+#else
+    case Level::AVX2:
+    case Level::AVX512:
+      return false;
+#endif
+  }
+  std::unreachable();
+}
+
+auto Kernels::select(Level level) -> Table {
+  ASSERT(isSupported(level), "Kernel level {} is not supported", levelToString(level));
+
+#ifdef LOGIC_X86_KERNELS
+  const auto popcount = __builtin_cpu_supports("popcnt") ? popcountHardware : popcountScalar;
+  switch (level) {
+    case Level::Scalar:
+      return {level, negationScalar, conjunctionScalar, disjunctionScalar, implicationScalar, bijectionScalar, popcount};
+    case Level::AVX2:
+      return {level, negationAVX2, conjunctionAVX2, disjunctionAVX2, implicationAVX2, bijectionAVX2, popcountAVX2};
+    case Level::AVX512:
+      // NOTE: `vpopcntq` is a separate extension from AVX-512F, fall back to the AVX2 count without it.
+      return {level, negationAVX512, conjunctionAVX512, disjunctionAVX512, implicationAVX512, bijectionAVX512,
+              __builtin_cpu_supports("avx512vpopcntdq") ? popcountAVX512 : popcountAVX2};
+  }
+#endif
+  return {Level::Scalar, negationScalar, conjunctionScalar, disjunctionScalar, implicationScalar, bijectionScalar, popcountScalar};
+}
+
+auto Kernels::table() -> Table& {
+  static Table table = [] {
+    for (auto level : {Level::AVX512, Level::AVX2}) {
+      if (isSupported(level)) return select(level);
+    }
+    return select(Level::Scalar);
+  }();
+  return table;
+}
+
+auto Kernels::level() -> Level {
+  return table().level;
+}
+
+auto Kernels::force(Level level) -> bool {
+  if (not isSupported(level)) {
+    return false;
+  }
+  table() = select(level);
+  return true;
+}
+
+auto Kernels::levelToString(Level level) -> std::string_view {
+  switch (level) {
+    case Level::Scalar:
+      return "scalar";
+    case Level::AVX2:
+      return "avx2";
+    case Level::AVX512:
+      return "avx512";
+  }
+  std::unreachable();
+}
+
+auto Kernels::levelFromString(std::string_view name) -> std::optional<Level> {
+  for (auto level : {Level::Scalar, Level::AVX2, Level::AVX512}) {
+    if (levelToString(level) == name) return level;
+  }
+  return std::nullopt;
+}
+
+auto Kernels::negation(Word* out, const Word* in, size_t words) -> void {
+  table().negation(out, in, words);
+}
+
+auto Kernels::conjunction(Word* out, const Word* p, const Word* q, size_t words) -> void {
+  table().conjunction(out, p, q, words);
+}
+
+auto Kernels::disjunction(Word* out, const Word* p, const Word* q, size_t words) -> void {
+  table().disjunction(out, p, q, words);
+}
+
+auto Kernels::implication(Word* out, const Word* p, const Word* q, size_t words) -> void {
+  table().implication(out, p, q, words);
+}
+
+auto Kernels::bijection(Word* out, const Word* p, const Word* q, size_t words) -> void {
+  table().bijection(out, p, q, words);
+}
+
+auto Kernels::popcount(const Word* in, size_t words) -> size_t {
+  return table().popcount(in, words);
+}
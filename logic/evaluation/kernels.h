@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace logic {
+
+// Word-level kernels used to evaluate packed truth-table columns.
+//
+// The best implementation supported by the running CPU is selected at startup, `force` can be
+// used to pin a specific level (e.g. to test every implementation on a single machine).
+class Kernels {
+
+public:
+  using Word = uint64_t;
+
+  enum class Level {
+    Scalar,
+    AVX2,
+    AVX512,
+  };
+
+  static auto negation(Word* out, const Word* in, size_t words) -> void;
+  static auto conjunction(Word* out, const Word* p, const Word* q, size_t words) -> void;
+  static auto disjunction(Word* out, const Word* p, const Word* q, size_t words) -> void;
+  static auto implication(Word* out, const Word* p, const Word* q, size_t words) -> void;
+  static auto bijection(Word* out, const Word* p, const Word* q, size_t words) -> void;
+  static auto popcount(const Word* in, size_t words) -> size_t;
+
+  static auto level() -> Level;
+  static auto isSupported(Level) -> bool;
+  static auto force(Level) -> bool;
+
+  static auto levelToString(Level) -> std::string_view;
+  static auto levelFromString(std::string_view) -> std::optional<Level>;
+
+private:
+  using UnaryKernel = void (*)(Word*, const Word*, size_t);
+  using BinaryKernel = void (*)(Word*, const Word*, const Word*, size_t);
+  using CountKernel = size_t (*)(const Word*, size_t);
+
+  struct Table {
+    Level level;
+    UnaryKernel negation;
+    BinaryKernel conjunction;
+    BinaryKernel disjunction;
+    BinaryKernel implication;
+    BinaryKernel bijection;
+    CountKernel popcount;
+  };
+
+  static auto select(Level) -> Table;
+  static auto table() -> Table&;
+};
+
+}
@@ -0,0 +1,48 @@
+#include "logic/evaluation/nodeTable.h"
+
+#include <utility>
+
+using namespace logic;
+
+auto NodeTable::intern(Node node) -> NodeId {
+  auto [it, inserted] = mIndex.try_emplace(node, NodeId(mNodes.size()));
+  if (inserted) {
+    mNodes.push_back(node);
+  }
+  return it->second;
+}
+
+auto NodeTable::variable(std::string_view name) -> NodeId {
+  auto [it, inserted] = mVariableIndex.try_emplace(name, NodeId(mVariables.size()));
+  if (inserted) {
+    mVariables.push_back(name);
+  }
+  return intern(Node(Node::Kind::Variable, it->second));
+}
+
+auto NodeTable::constant(bool value) -> NodeId {
+  return intern(Node(Node::Kind::Constant, value));
+}
+
+auto NodeTable::negation(NodeId operand) -> NodeId {
+  return intern(Node(Node::Kind::Negation, operand));
+}
+
+auto NodeTable::binary(Node::Kind kind, NodeId left, NodeId right) -> NodeId {
+  return intern(Node(kind, left, right));
+}
+
+auto NodeTable::kindOf(TokenType connective) -> Node::Kind {
+  switch (connective) {
+    case TokenType::And:
+      return Node::Kind::Conjunction;
+    case TokenType::Or:
+      return Node::Kind::Disjunction;
+    case TokenType::Implies:
+      return Node::Kind::Implication;
+    case TokenType::Equivalent:
+      return Node::Kind::Bijection;
+    default:
+      std::unreachable();
+  }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "logic/parsing/token.h"
+
+namespace logic {
+
+using NodeId = uint32_t;
+
+// A node of a hash-consed sentence, children always have a smaller id than their parents.
+struct Node {
+  enum class Kind : uint8_t {
+    Variable,
+    Constant,
+    Negation,
+    Conjunction,
+    Disjunction,
+    Implication,
+    Bijection,
+  };
+
+  Kind kind;
+  // the interned variable for `Variable`, the boolean for `Constant` and the operands otherwise.
+  NodeId left = 0;
+  NodeId right = 0;
+
+  constexpr auto isBinary() const -> bool {
+    return kind != Kind::Variable and kind != Kind::Constant and kind != Kind::Negation;
+  }
+
+  friend constexpr auto operator==(const Node&, const Node&) -> bool = default;
+
+  struct Hash {
+    constexpr auto operator()(const Node& node) const -> size_t {
+      auto hash = size_t(node.kind);
+      hash = hash * 0x9E3779B97F4A7C15 + node.left;
+      hash = hash * 0x9E3779B97F4A7C15 + node.right;
+      return hash ^ (hash >> 29);
+    }
+  };
+};
+
+// Maps structurally equal sub-sentences to a single node, so a formula becomes a DAG in which
+// every distinct sub-formula appears exactly once.
+class NodeTable {
+
+private:
+  std::vector<Node> mNodes;
+  std::unordered_map<Node, NodeId, Node::Hash> mIndex;
+  std::vector<std::string_view> mVariables;
+  std::unordered_map<std::string_view, NodeId> mVariableIndex;
+
+public:
+  auto variable(std::string_view name) -> NodeId;
+  auto constant(bool value) -> NodeId;
+  auto negation(NodeId operand) -> NodeId;
+  auto binary(Node::Kind kind, NodeId left, NodeId right) -> NodeId;
+
+  static auto kindOf(TokenType connective) -> Node::Kind;
+
+  constexpr auto operator[](NodeId id) const -> const Node& {
+    return mNodes[id];
+  }
+
+  constexpr auto size() const -> size_t {
+    return mNodes.size();
+  }
+
+  constexpr auto variableName(const Node& node) const -> std::string_view {
+    return mVariables[node.left];
+  }
+
+  // the interned variable names, indexed by the `left` field of `Variable` nodes.
+  constexpr auto variables() const -> const std::vector<std::string_view>& {
+    return mVariables;
+  }
+
+private:
+  auto intern(Node node) -> NodeId;
+};
+
+}
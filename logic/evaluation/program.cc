@@ -0,0 +1,695 @@
+#include "logic/evaluation/program.h"
+#include "logic/evaluation/kernels.h"
+#include "logic/evaluation/nodeTable.h"
+
+#include "logic/utils/macros.h"
+#include "logic/utils/overloaded.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+using namespace logic;
+
+namespace {
+
+class Compiler {
+
+private:
+  struct Record {
+    NodeId key;
+    NodeId value;
+    std::string name;
+  };
+
+  const Environment& mEnvironment;
+  bool mRecordColumns;
+  bool mCached;
+  Program mProgram;
+
+  NodeTable mNodes;
+  std::vector<Record> mRecords;
+  std::unordered_set<NodeId> mRecordedKeys;
+
+  std::vector<uint32_t> mRegisterOf;
+  std::vector<uint32_t> mUses;
+  std::vector<uint32_t> mNeeds;
+  std::vector<bool> mPinnedNodes;
+
+  std::vector<uint32_t> mFreeRegisters;
+  std::vector<bool> mPinned;
+
+  // the number of connectives of every node, and whether none of its inner nodes is pinned or read outside of it.
+  std::vector<size_t> mSizes;
+  std::vector<bool> mEnclosed;
+
+  // the guard of every node that is looked up in the cache, by node, and the fingerprint of every node.
+  std::unordered_map<NodeId, uint32_t> mGuards;
+  std::vector<Fingerprint> mFingerprints;
+  // the nodes that were given a register, in the order they are evaluated.
+  std::vector<NodeId> mEvaluated;
+
+  static constexpr auto NO_REGISTER = std::numeric_limits<uint32_t>::max();
+  static constexpr auto NO_LOOKUP = std::numeric_limits<size_t>::max();
+  // NOTE: below this many connectives evaluating a sub-sentence is about as cheap as looking it up.
+  static constexpr size_t MIN_CACHED_CONNECTIVES = 16;
+  // NOTE: testing whether a block is decided usually stops at its first word, but skipping a single
+  //       connective does not make up for the extra instruction.
+  static constexpr size_t MIN_SKIPPED_CONNECTIVES = 2;
+
+  struct ShortCircuit {
+    NodeId first;
+    bool decisive;
+    bool decision;
+  };
+
+  // A node whose operands are being emitted, see `emit`.
+  struct Frame {
+    NodeId id;
+    // the `LoadCached` of the node, if it is looked up in the cache, and where the nodes evaluated
+    // inside of it start in `mEvaluated`.
+    size_t lookup;
+    size_t evaluated;
+    // where the operands of the node start in `mOperands`, in the order they are emitted.
+    size_t operands;
+    size_t count = 0;
+    size_t next = 0;
+    // where the jumps past the operands start in `mJumps`.
+    size_t jumps = 0;
+    // whether the operands are those of a flattened chain, see `chain`.
+    bool chain = false;
+    size_t firstSkippable = 0;
+    // whether the right operand of a binary connective is emitted first.
+    bool swapped = false;
+    std::optional<ShortCircuit> circuit;
+    // the register of the first operand, and then of the running result.
+    uint32_t result = 0;
+  };
+
+  std::vector<Frame> mFrames;
+  std::vector<NodeId> mOperands;
+  // the connectives left to evaluate from every operand of a chain on, see `chain`.
+  std::vector<size_t> mRemaining;
+  std::vector<size_t> mJumps;
+
+public:
+  Compiler(const Environment& environment, bool recordColumns, bool cached)
+    : mEnvironment(environment), mRecordColumns(recordColumns), mCached(cached) {}
+
+  auto compile(const Sentence& sentence) -> Program {
+    // NOTE: the defined variables are always the first columns of the table, in the order of the environment.
+    std::vector<NodeId> variables;
+    if (mRecordColumns) {
+      for (const auto& variable : mEnvironment.definedVariables()) {
+        variables.push_back(mNodes.variable(variable));
+      }
+    }
+
+    const auto root = lower(sentence);
+
+    mRegisterOf.assign(mNodes.size(), NO_REGISTER);
+    mPinnedNodes.assign(mNodes.size(), false);
+    countUses(root);
+
+    for (auto node : variables) {
+      mPinnedNodes[node] = true;
+      mProgram.outputs.emplace_back(std::string(mNodes.variableName(mNodes[node])), emit(node));
+    }
+    for (const auto& record : mRecords) {
+      mPinnedNodes[record.value] = true;
+    }
+    measure();
+    if (mCached) {
+      planGuards(root);
+    }
+
+    mProgram.result = emit(root);
+    for (auto& record : mRecords) {
+      mProgram.outputs.emplace_back(std::move(record.name), mRegisterOf[record.value]);
+    }
+    return std::move(mProgram);
+  }
+
+private:
+  // Interns the sentence into the node table and lists the columns of the truth table in the
+  // order they are shown, columns of structurally equal sub-sentences are only shown once.
+  auto lower(const Sentence& sentence) -> NodeId {
+    // NOTE: the node of every sentence that was left is pushed, those of its operands are on top.
+    auto lowered = std::vector<NodeId>();
+    const auto pop = [&] {
+      const auto node = lowered.back();
+      lowered.pop_back();
+      return node;
+    };
+
+    // NOTE: assignments are lowered when they are left, the variable they assign is not an operand.
+    const auto enter = [](const Sentence& sentence) {
+      return not sentence.is<Sentence::Compound>() or sentence.unsafeAsRef<Sentence::Compound>().connective.type != TokenType::Equal;
+    };
+
+    Sentence::walk(sentence, enter, [&](const Sentence& sentence) {
+      sentence.accept(overloaded {
+        [&](const Sentence::Variable& s) {
+          auto node = mNodes.variable(s.identifier.lexeme);
+          record(sentence, node, node);
+          lowered.push_back(node);
+        },
+        [&](const Sentence::Value& s) {
+          ASSERT(s.value.type == TokenType::True or s.value.type == TokenType::False);
+          lowered.push_back(mNodes.constant(s.value.type == TokenType::True));
+        },
+        [](const Sentence::Grouped&) {},
+        [](const Sentence::Query&) {},
+        [&](const Sentence::Negated&) {
+          auto node = mNodes.negation(pop());
+          record(sentence, node, node);
+          lowered.push_back(node);
+        },
+        [&](const Sentence::Compound& s) {
+          if (s.connective.type == TokenType::Equal) {
+            // NOTE: the assigned variable is shown with the value of the right-hand side.
+            auto node = lower(*s.right);
+            auto variable = mNodes.variable(s.left->unsafeAs<Sentence::Variable>().identifier.lexeme);
+            record(*s.left, variable, node);
+            lowered.push_back(node);
+            return;
+          }
+
+          auto rhs = pop();
+          auto lhs = pop();
+          record(*s.left, lhs, lhs);
+          record(*s.right, rhs, rhs);
+
+          auto node = mNodes.binary(NodeTable::kindOf(s.connective.type), lhs, rhs);
+          record(sentence, node, node);
+          lowered.push_back(node);
+        },
+      });
+    });
+    return lowered.back();
+  }
+
+  auto record(const Sentence& sentence, NodeId key, NodeId value) -> void {
+    if (not mRecordColumns) return;
+
+    if (sentence.is<Sentence::Variable>()) {
+      // skip recording variables if they have "default" values, as they are recorded at the start.
+      const auto isVariableAssigned = mEnvironment.isVariableAssigned(sentence.unsafeAs<Sentence::Variable>().identifier.lexeme);
+      if (not isVariableAssigned) return;
+    }
+
+    if (sentence.is<Sentence::Value>()) return;
+    if (sentence.is<Sentence::Grouped>()) return;
+    if (sentence.is<Sentence::Query>()) return;
+
+    if (not mRecordedKeys.insert(key).second) return;
+
+    mRecords.emplace_back(key, value, Sentence::asString(sentence));
+  }
+
+  // Counts how many instructions read every node, and how many registers evaluating it needs (Sethi-Ullman).
+  auto countUses(NodeId root) -> void {
+    mUses.assign(mNodes.size(), 0);
+    mNeeds.assign(mNodes.size(), 1);
+
+    std::vector<bool> visited(mNodes.size(), false);
+    visited[root] = true;
+
+    // NOTE: children always have smaller ids, so walking the ids downwards visits every parent before its children.
+    for (auto id = NodeId(mNodes.size()); id-- > 0;) {
+      if (not visited[id]) continue;
+
+      const auto& node = mNodes[id];
+      if (node.kind == Node::Kind::Negation) {
+        mUses[node.left] += 1;
+        visited[node.left] = true;
+      } else if (node.isBinary()) {
+        mUses[node.left] += 1;
+        mUses[node.right] += 1;
+        visited[node.left] = true;
+        visited[node.right] = true;
+      }
+    }
+
+    for (NodeId id = 0; id < mNodes.size(); id++) {
+      const auto& node = mNodes[id];
+      if (node.kind == Node::Kind::Negation) {
+        mNeeds[id] = mNeeds[node.left];
+      } else if (node.isBinary()) {
+        auto left = mNeeds[node.left];
+        auto right = mNeeds[node.right];
+        mNeeds[id] = left == right ? left + 1 : std::max(left, right);
+      }
+    }
+  }
+
+  auto measure() -> void {
+    mSizes.assign(mNodes.size(), 0);
+    mEnclosed.assign(mNodes.size(), true);
+
+    for (NodeId id = 0; id < mNodes.size(); id++) {
+      const auto& node = mNodes[id];
+      if (isLeaf(node)) continue;
+
+      const NodeId operands[] = {node.left, node.right};
+      mSizes[id] = 1;
+      for (auto child : std::span(operands, node.isBinary() ? 2 : 1)) {
+        mSizes[id] = std::min(mSizes[id] + mSizes[child], std::numeric_limits<size_t>::max() / 2);
+        mEnclosed[id] = mEnclosed[id] and not mPinnedNodes[child]
+                          and (isLeaf(mNodes[child]) or (mEnclosed[child] and mUses[child] == 1));
+      }
+    }
+  }
+
+  // Whether the instructions of a node can be jumped over, which is the case when its column is only
+  // read by its parent and none of the registers set below it is read anywhere else.
+  //
+  // NOTE: a node shared inside of the operand is not skipped either, checking the sub-sentence as a
+  //       tree keeps this a lookup.
+  auto isSkippable(NodeId id) -> bool {
+    if (mPinnedNodes[id]) return false;
+    return isLeaf(mNodes[id]) or (mUses[id] == 1 and mEnclosed[id]);
+  }
+
+  // `A IMPLIES B` is decided by a block of false rows in `A` or of true rows in `B`, the smaller
+  // operand goes first since it is the cheaper one to test.
+  auto shortCircuit(const Node& node) -> std::optional<ShortCircuit> {
+    if (mRecordColumns or node.kind != Node::Kind::Implication) return std::nullopt;
+
+    const auto antecedentFirst = mSizes[node.left] <= mSizes[node.right];
+    const auto second = antecedentFirst ? node.right : node.left;
+    if (not isSkippable(second) or mSizes[second] < MIN_SKIPPED_CONNECTIVES) return std::nullopt;
+
+    return ShortCircuit(antecedentFirst ? node.left : node.right, not antecedentFirst, true);
+  }
+
+  // Picks the sub-sentences that are looked up in the cache. Sentences tend to share whole operands
+  // such as `(...) IMPLIES P`, so only the top of a chain of the same connective is looked up, and only
+  // if it has `MIN_CACHED_CONNECTIVES` more connectives than the largest sub-sentence looked up inside
+  // of it, which bounds the lookups per block.
+  //
+  // NOTE: skipping a sub-sentence on a hit must not leave a register unset that is read later, the
+  //       columns it needs to restore are only known once it is emitted, see `finish`.
+  auto planGuards(NodeId root) -> void {
+    const auto variables = mEnvironment.definedVariables().size();
+
+    auto chainTops = std::vector<bool>(mNodes.size(), false);
+    chainTops[root] = true;
+    for (auto id = NodeId(mNodes.size()); id-- > 0;) {
+      const auto& node = mNodes[id];
+      if (node.kind == Node::Kind::Negation or node.isBinary()) {
+        chainTops[node.left] = chainTops[node.left] or mNodes[node.left].kind != node.kind;
+      }
+      if (node.isBinary()) {
+        chainTops[node.right] = chainTops[node.right] or mNodes[node.right].kind != node.kind;
+      }
+    }
+
+    mFingerprints.assign(mNodes.size(), Fingerprint());
+    auto largestGuard = std::vector<size_t>(mNodes.size(), 0);
+
+    for (NodeId id = 0; id < mNodes.size(); id++) {
+      const auto& node = mNodes[id];
+      switch (node.kind) {
+        case Node::Kind::Variable: {
+          const auto name = mNodes.variableName(node);
+          if (mEnvironment.isVariableAssigned(name)) {
+            mFingerprints[id] = Fingerprint::leaf(Node::Kind::Constant, mEnvironment.read(name, 0, 1).test(0));
+          } else {
+            mFingerprints[id] = Fingerprint::leaf(Node::Kind::Variable, variables - 1 - *mEnvironment.slotOf(name));
+          }
+          continue;
+        }
+        case Node::Kind::Constant:
+          mFingerprints[id] = Fingerprint::leaf(Node::Kind::Constant, node.left);
+          continue;
+        default:
+          break;
+      }
+
+      const NodeId operands[] = {node.left, node.right};
+      for (auto child : std::span(operands, node.isBinary() ? 2 : 1)) {
+        largestGuard[id] = std::max(largestGuard[id], mGuards.contains(child) ? mSizes[child] : largestGuard[child]);
+      }
+      mFingerprints[id] = node.isBinary() ? Fingerprint::node(node.kind, mFingerprints[node.left], mFingerprints[node.right])
+                                          : Fingerprint::node(node.kind, mFingerprints[node.left]);
+
+      if (chainTops[id] and mSizes[id] >= largestGuard[id] + MIN_CACHED_CONNECTIVES) {
+        mGuards.emplace(id, uint32_t(mProgram.guards.size()));
+        mProgram.guards.emplace_back(mFingerprints[id]);
+      }
+    }
+  }
+
+  // Emits the instructions of a node after those of its operands. The operands are emitted from an
+  // explicit stack of frames instead of recursively, so sentences nested arbitrarily deep do not
+  // overflow the stack, see `enter`, `combine` and `leave`.
+  auto emit(NodeId root) -> uint32_t {
+    auto reg = enter(root);
+    while (not mFrames.empty()) {
+      auto& frame = mFrames.back();
+      if (reg != NO_REGISTER) {
+        combine(frame, reg);
+        frame.next++;
+      }
+      if (frame.next == frame.count) {
+        reg = leave();
+        continue;
+      }
+
+      jump(frame);
+      reg = enter(mOperands[frame.operands + frame.next]);
+    }
+    return reg;
+  }
+
+  // Emits a node that already has a register or is a leaf right away, and otherwise pushes a frame
+  // with its operands in the order they are emitted.
+  auto enter(NodeId id) -> uint32_t {
+    if (mRegisterOf[id] != NO_REGISTER) {
+      return mRegisterOf[id];
+    }
+
+    // NOTE: the register of the column is only known once it is evaluated, the lookup is patched afterwards.
+    auto lookup = NO_LOOKUP;
+    if (const auto guard = mGuards.find(id); guard != mGuards.end()) {
+      lookup = mProgram.instructions.size();
+      mProgram.instructions.emplace_back(OpCode::LoadCached, 0, guard->second);
+    }
+
+    const auto node = mNodes[id];
+    if (node.kind == Node::Kind::Variable) {
+      auto name = mNodes.variableName(node);
+      if (mEnvironment.isVariableAssigned(name)) {
+        return finish(id, emitInstruction(OpCode::LoadConstant, mEnvironment.read(name, 0, 1).test(0)), lookup, mEvaluated.size());
+      }
+      auto slot = mEnvironment.slotOf(name);
+      ASSERT(slot.has_value());
+      return finish(id, emitInstruction(OpCode::LoadVariable, *slot), lookup, mEvaluated.size());
+    }
+    if (node.kind == Node::Kind::Constant) {
+      return finish(id, emitInstruction(OpCode::LoadConstant, node.left), lookup, mEvaluated.size());
+    }
+
+    auto& frame = mFrames.emplace_back(id, lookup, mEvaluated.size(), mOperands.size());
+    frame.jumps = mJumps.size();
+
+    if (node.kind == Node::Kind::Negation) {
+      mOperands.push_back(node.left);
+    } else if (not mRecordColumns and (node.kind == Node::Kind::Conjunction or node.kind == Node::Kind::Disjunction)) {
+      frame.chain = true;
+      frame.firstSkippable = chain(id);
+    } else if (const auto circuit = shortCircuit(node)) {
+      frame.circuit = circuit;
+      frame.swapped = circuit->first != node.left;
+      mOperands.push_back(circuit->first);
+      mOperands.push_back(frame.swapped ? node.left : node.right);
+    } else {
+      // NOTE: without columns to record the order of the operands is free, starting with the operand
+      //       that needs more registers keeps the number of live registers minimal.
+      frame.swapped = not mRecordColumns and mNeeds[node.right] > mNeeds[node.left];
+      mOperands.push_back(frame.swapped ? node.right : node.left);
+      mOperands.push_back(frame.swapped ? node.left : node.right);
+    }
+
+    frame.count = mOperands.size() - frame.operands;
+    mRemaining.resize(mOperands.size(), 0);
+    return NO_REGISTER;
+  }
+
+  // Evaluates a chain of `AND` or `OR` as a running result over its operands, so it needs no more
+  // registers than its largest operand whatever the shape of the chain. The operands whose column is
+  // needed elsewhere go first and the others from the smallest to the largest, and once a block of the
+  // running result is all false for `AND` or all true for `OR` a `ShortCircuit` jumps past the rest.
+  // Returns the first operand that can be skipped.
+  //
+  // NOTE: the order of the operands is free since the inner nodes of the chain are not shown.
+  auto chain(NodeId id) -> size_t {
+    const auto kind = mNodes[id].kind;
+    const auto first = mOperands.size();
+
+    auto pending = std::vector<NodeId>{mNodes[id].right, mNodes[id].left};
+    while (not pending.empty()) {
+      const auto current = pending.back();
+      pending.pop_back();
+
+      const auto& node = mNodes[current];
+      const auto inner = node.kind == kind and mUses[current] == 1 and not mPinnedNodes[current]
+                           and mRegisterOf[current] == NO_REGISTER and not mGuards.contains(current);
+      if (inner) {
+        pending.push_back(node.right);
+        pending.push_back(node.left);
+      } else {
+        mOperands.push_back(current);
+      }
+    }
+
+    const auto operands = std::span(mOperands).subspan(first);
+    std::ranges::stable_sort(operands, {}, [this](NodeId operand) { return std::pair(isSkippable(operand), mSizes[operand]); });
+
+    // the connectives left to evaluate from every operand on, counting the one that combines it.
+    mRemaining.resize(mOperands.size() + 1, 0);
+    for (auto i = mOperands.size(); i-- > first;) {
+      mRemaining[i] = mRemaining[i + 1] + mSizes[mOperands[i]] + 1;
+    }
+    mRemaining.pop_back();
+
+    return std::ranges::find_if(operands, [this](NodeId operand) { return isSkippable(operand); }) - operands.begin();
+  }
+
+  // Places a `ShortCircuit` before the next operand of the frame when the operands before it may decide a block.
+  //
+  // NOTE: the register of the connective is only known once every operand is emitted, the jumps are patched afterwards.
+  auto jump(const Frame& frame) -> void {
+    if (frame.next == 0) return;
+
+    if (frame.chain) {
+      if (frame.next < frame.firstSkippable or mRemaining[frame.operands + frame.next] < MIN_SKIPPED_CONNECTIVES) return;
+      const auto decisive = mNodes[frame.id].kind == Node::Kind::Disjunction;
+      mJumps.push_back(mProgram.instructions.size());
+      mProgram.instructions.emplace_back(OpCode::ShortCircuit, 0, frame.result, 0, decisive, decisive);
+    } else if (frame.circuit) {
+      mJumps.push_back(mProgram.instructions.size());
+      mProgram.instructions.emplace_back(OpCode::ShortCircuit, 0, frame.result, 0, frame.circuit->decisive, frame.circuit->decision);
+    }
+  }
+
+  // Takes the register of the operand of the frame that was just emitted.
+  auto combine(Frame& frame, uint32_t reg) -> void {
+    const auto node = mNodes[frame.id];
+    if (node.kind == Node::Kind::Negation) {
+      release(node.left, reg);
+      frame.result = emitInstruction(OpCode::Negation, reg);
+      return;
+    }
+    if (frame.next == 0) {
+      frame.result = reg;
+      return;
+    }
+
+    if (frame.chain) {
+      if (frame.next == 1) {
+        release(mOperands[frame.operands], frame.result);
+      } else {
+        mFreeRegisters.push_back(frame.result);
+      }
+      release(mOperands[frame.operands + frame.next], reg);
+      frame.result = emitInstruction(opcodeOf(node.kind), frame.result, reg);
+      return;
+    }
+
+    const auto lhs = frame.swapped ? reg : frame.result;
+    const auto rhs = frame.swapped ? frame.result : reg;
+    release(node.left, lhs);
+    release(node.right, rhs);
+    frame.result = emitInstruction(opcodeOf(node.kind), lhs, rhs);
+  }
+
+  // Pops the frame on top once all of its operands are emitted.
+  auto leave() -> uint32_t {
+    const auto frame = std::move(mFrames.back());
+    mFrames.pop_back();
+
+    for (auto i = frame.jumps; i < mJumps.size(); i++) {
+      mProgram.instructions[mJumps[i]].destination = frame.result;
+      mProgram.instructions[mJumps[i]].right = uint32_t(mProgram.instructions.size());
+    }
+    mJumps.resize(frame.jumps);
+    mOperands.resize(frame.operands);
+    mRemaining.resize(frame.operands);
+    return finish(frame.id, frame.result, frame.lookup, frame.evaluated);
+  }
+
+  // NOTE: a node that is looked up in the cache restores the columns evaluated inside of it that are
+  //       still read afterwards, they are part of its fingerprint since they depend on what was
+  //       evaluated before it and on which columns are shown.
+  auto finish(NodeId id, uint32_t reg, size_t lookup, size_t inside) -> uint32_t {
+    if (lookup != NO_LOOKUP) {
+      auto& guard = mProgram.guards[mProgram.instructions[lookup].left];
+      for (auto inner : std::span(mEvaluated).subspan(inside)) {
+        if (not mPinnedNodes[inner] and mUses[inner] == 0) continue;
+        guard.columns.push_back(mRegisterOf[inner]);
+        guard.fingerprint = Fingerprint::group(guard.fingerprint, mFingerprints[inner]);
+      }
+
+      mProgram.instructions.emplace_back(OpCode::StoreCached, reg, mProgram.instructions[lookup].left);
+      mProgram.instructions[lookup].destination = reg;
+      mProgram.instructions[lookup].right = uint32_t(mProgram.instructions.size());
+    }
+
+    if (mPinnedNodes[id]) {
+      mPinned[reg] = true;
+    }
+    // NOTE: loads are as cheap as keeping their result alive, leaves are reloaded by every parent
+    //       instead of holding on to a register until the last use.
+    if (not isLeaf(mNodes[id]) or mPinnedNodes[id]) {
+      mRegisterOf[id] = reg;
+      mEvaluated.push_back(id);
+    }
+    return reg;
+  }
+
+  static auto opcodeOf(Node::Kind kind) -> OpCode {
+    switch (kind) {
+      case Node::Kind::Conjunction:
+        return OpCode::Conjunction;
+      case Node::Kind::Disjunction:
+        return OpCode::Disjunction;
+      case Node::Kind::Implication:
+        return OpCode::Implication;
+      case Node::Kind::Bijection:
+        return OpCode::Bijection;
+      default:
+        std::unreachable();
+    }
+  }
+
+  auto emitInstruction(OpCode opcode, uint32_t left = 0, uint32_t right = 0) -> uint32_t {
+    auto reg = allocate();
+    mProgram.instructions.emplace_back(opcode, reg, left, right);
+    return reg;
+  }
+
+  auto allocate() -> uint32_t {
+    if (not mFreeRegisters.empty()) {
+      auto reg = mFreeRegisters.back();
+      mFreeRegisters.pop_back();
+      return reg;
+    }
+    mPinned.push_back(false);
+    return mProgram.registers++;
+  }
+
+  // NOTE: a node shared by several parents keeps its register until the last of them has been emitted.
+  auto release(NodeId id, uint32_t reg) -> void {
+    mUses[id] -= 1;
+    if (mPinned[reg]) return;
+    if (mUses[id] == 0 or mRegisterOf[id] == NO_REGISTER) {
+      mFreeRegisters.push_back(reg);
+    }
+  }
+
+  static auto isLeaf(const Node& node) -> bool {
+    return node.kind == Node::Kind::Variable or node.kind == Node::Kind::Constant;
+  }
+};
+
+}
+
+auto Program::compile(const Sentence& sentence, const Environment& environment, bool recordColumns, bool cached) -> Program {
+  return Compiler(environment, recordColumns, cached).compile(sentence);
+}
+
+auto Machine::run(const Program& program, const Environment& environment, RowRange range, ColumnCache* cache) -> void {
+  mRegisters.resize(program.registers);
+
+  for (size_t pc = 0; pc < program.instructions.size(); pc++) {
+    const auto& instruction = program.instructions[pc];
+    auto& out = mRegisters[instruction.destination];
+    out.resize(range.rows);
+
+    const auto words = out.words.size();
+    auto* destination = out.words.data();
+
+    switch (instruction.opcode) {
+      case OpCode::LoadVariable:
+        environment.read(instruction.left, range, out);
+        continue;
+      case OpCode::LoadConstant:
+        out.fill(instruction.left != 0);
+        continue;
+      case OpCode::LoadCached:
+        if (cache != nullptr and load(program.guards[instruction.left], instruction.destination, range, *cache)) {
+          pc = instruction.right - 1;
+        }
+        continue;
+      case OpCode::StoreCached:
+        if (cache != nullptr) {
+          store(program.guards[instruction.left], instruction.destination, range, *cache);
+        }
+        continue;
+      case OpCode::ShortCircuit:
+        if (mRegisters[instruction.left].all(instruction.decisive)) {
+          out.fill(instruction.decision);
+          pc = instruction.right - 1;
+        }
+        continue;
+      case OpCode::Negation:
+        Kernels::negation(destination, mRegisters[instruction.left].words.data(), words);
+        break;
+      case OpCode::Conjunction:
+        Kernels::conjunction(destination, mRegisters[instruction.left].words.data(), mRegisters[instruction.right].words.data(), words);
+        break;
+      case OpCode::Disjunction:
+        Kernels::disjunction(destination, mRegisters[instruction.left].words.data(), mRegisters[instruction.right].words.data(), words);
+        break;
+      case OpCode::Implication:
+        Kernels::implication(destination, mRegisters[instruction.left].words.data(), mRegisters[instruction.right].words.data(), words);
+        break;
+      case OpCode::Bijection:
+        Kernels::bijection(destination, mRegisters[instruction.left].words.data(), mRegisters[instruction.right].words.data(), words);
+        break;
+    }
+    out.clearPadding();
+  }
+}
+
+auto Machine::load(const Program::Guard& guard, uint32_t reg, RowRange range, ColumnCache& cache) -> bool {
+  if (guard.columns.empty()) {
+    return cache.lookup(guard.fingerprint, range, mRegisters[reg]);
+  }
+  if (not cache.lookup(guard.fingerprint, range, mGroup)) {
+    return false;
+  }
+
+  const auto words = Value::wordsFor(range.rows);
+  auto next = mGroup.words.begin();
+  const auto restore = [&](uint32_t reg) {
+    mRegisters[reg].resize(range.rows);
+    std::copy_n(next, words, mRegisters[reg].words.begin());
+    next += words;
+  };
+  restore(reg);
+  for (auto column : guard.columns) {
+    restore(column);
+  }
+  return true;
+}
+
+auto Machine::store(const Program::Guard& guard, uint32_t reg, RowRange range, ColumnCache& cache) -> void {
+  if (guard.columns.empty()) {
+    cache.insert(guard.fingerprint, range, mRegisters[reg]);
+    return;
+  }
+
+  mGroup.words.assign(mRegisters[reg].words.begin(), mRegisters[reg].words.end());
+  for (auto column : guard.columns) {
+    mGroup.words.insert(mGroup.words.end(), mRegisters[column].words.begin(), mRegisters[column].words.end());
+  }
+  mGroup.size = mGroup.words.size() * Value::WORD_BITS;
+  cache.insert(guard.fingerprint, range, mGroup);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "logic/evaluation/columnCache.h"
+#include "logic/evaluation/environment.h"
+#include "logic/evaluation/value.h"
+#include "logic/parsing/sentence.h"
+
+namespace logic {
+
+enum class OpCode : uint8_t {
+  LoadVariable,
+  LoadConstant,
+  Negation,
+  Conjunction,
+  Disjunction,
+  Implication,
+  Bijection,
+  LoadCached,
+  StoreCached,
+  ShortCircuit,
+};
+
+// `left` holds the environment slot of the variable for `LoadVariable` and the boolean for `LoadConstant`,
+// every other operand is a register. `LoadCached` and `StoreCached` bracket the instructions of a cached
+// sub-sentence: `left` is its guard, `destination` the register of its column, and a hit in `LoadCached`
+// jumps to the instruction in `right`.
+//
+// `ShortCircuit` follows the instructions of the operand of a connective that is evaluated first, in
+// `left`. When every row of the block is `decisive` it fills `destination`, the register of the
+// connective, with `decision` and jumps to `right` past the other operand and the connective.
+struct Instruction {
+  OpCode opcode;
+  uint32_t destination;
+  uint32_t left = 0;
+  uint32_t right = 0;
+  bool decisive = false;
+  bool decision = false;
+};
+
+// A sentence lowered into a flat postfix sequence of instructions over a fixed set of column
+// registers. Registers are reused as soon as their value has been consumed unless they hold a
+// column that has to be printed.
+struct Program {
+  struct Output {
+    std::string name;
+    uint32_t reg;
+  };
+
+  // A sub-sentence that is looked up in the cache. The columns evaluated inside of it that are read
+  // after it, such as the columns of a truth table, are cached along with its own in `columns`.
+  struct Guard {
+    Fingerprint fingerprint;
+    std::vector<uint32_t> columns;
+  };
+
+  std::vector<Instruction> instructions;
+  std::vector<Guard> guards;
+  std::vector<Output> outputs;
+  uint32_t registers = 0;
+  uint32_t result = 0;
+
+  // The environment must already contain every variable of the sentence (see `Evaluator::initializeVariables`),
+  // and must not change while the program is run since variables are loaded by their slot.
+  // When `recordColumns` is set, `outputs` lists the columns of the truth table in the order they are printed.
+  // When `cached` is set, large sub-sentences are looked up in the cache the program is run with before being
+  // evaluated.
+  static auto compile(const Sentence&, const Environment&, bool recordColumns = true, bool cached = false) -> Program;
+};
+
+// Runs a program over a block of rows, the registers are kept between runs so evaluating the
+// same program over many blocks does not allocate.
+class Machine {
+
+private:
+  std::vector<Value> mRegisters;
+  // the columns of a guard laid end to end, they are one entry of the cache so they are evicted together.
+  Value mGroup;
+
+  auto load(const Program::Guard&, uint32_t reg, RowRange, ColumnCache&) -> bool;
+  auto store(const Program::Guard&, uint32_t reg, RowRange, ColumnCache&) -> void;
+
+public:
+  auto run(const Program&, const Environment&, RowRange, ColumnCache* = nullptr) -> void;
+
+  constexpr auto at(uint32_t reg) const -> const Value& {
+    return mRegisters[reg];
+  }
+};
+
+}
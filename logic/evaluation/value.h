@@ -1,24 +1,115 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
 #include <variant>
 #include <vector>
 
+#include "logic/evaluation/kernels.h"
 #include "logic/utils/macros.h"
 
 namespace logic {
 
+struct RowRange {
+  size_t start;
+  size_t rows;
+};
+
+// A column of a truth table, packed 64 rows per word. Row `i` lives at bit `i % 64` of word `i / 64`.
+// Bits past `size` are always kept at zero so that words can be compared and counted directly.
 class Value {
 
 public:
-  std::vector<bool> data;
+  using Word = Kernels::Word;
+  static constexpr size_t WORD_BITS = 64;
+
+  std::vector<Word> words;
+  size_t size = 0;
+
+  constexpr Value() = default;
+
+  constexpr Value(bool value) : Value(value, 1) {}
+
+  constexpr Value(const std::vector<bool>& value) : words(wordsFor(value.size())), size(value.size()) {
+    for (size_t i=0; i<value.size(); i++) {
+      set(i, value[i]);
+    }
+  }
+
+  constexpr Value(std::initializer_list<bool> value) : words(wordsFor(value.size())), size(value.size()) {
+    size_t i = 0;
+    for (auto bit : value) {
+      set(i++, bit);
+    }
+  }
+
+  constexpr Value(bool value, size_t size) : words(wordsFor(size), value ? ~Word(0) : Word(0)), size(size) {
+    clearPadding();
+  }
+
+  // NOTE: the contents are left unspecified, this is meant for buffers that are about to be overwritten.
+  constexpr auto resize(size_t rows) -> void {
+    words.resize(wordsFor(rows));
+    size = rows;
+  }
+
+  constexpr auto fill(bool value) -> void {
+    std::fill(words.begin(), words.end(), value ? ~Word(0) : Word(0));
+    clearPadding();
+  }
+
+  static constexpr auto wordsFor(size_t rows) -> size_t {
+    return (rows + WORD_BITS - 1) / WORD_BITS;
+  }
+
+  constexpr auto test(size_t i) const -> bool {
+    return (words[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+  }
+
+  constexpr auto set(size_t i, bool value) -> void {
+    auto mask = Word(1) << (i % WORD_BITS);
+    if (value) {
+      words[i / WORD_BITS] |= mask;
+    } else {
+      words[i / WORD_BITS] &= ~mask;
+    }
+  }
 
-  constexpr Value(bool value) : data{value} {}
-  constexpr Value(std::vector<bool> value) : data(value) {}
-  constexpr Value(std::initializer_list<bool> value) : data(value) {}
+  // Whether every row holds `value`, the scan stops at the first word that differs.
+  constexpr auto all(bool value) const -> bool {
+    if (not value) {
+      return std::all_of(words.begin(), words.end(), [](Word word) { return word == 0; });
+    }
+    const auto full = size / WORD_BITS;
+    for (size_t i = 0; i < full; i++) {
+      if (words[i] != ~Word(0)) return false;
+    }
+    const auto remainder = size % WORD_BITS;
+    return remainder == 0 or words[full] == (Word(1) << remainder) - 1;
+  }
+
+  // The first row that holds `value`, or `size` when no row does.
+  constexpr auto find(bool value) const -> size_t {
+    for (size_t i = 0; i < words.size(); i++) {
+      const auto word = value ? words[i] : ~words[i];
+      if (word != 0) return std::min(size, i * WORD_BITS + std::countr_zero(word));
+    }
+    return size;
+  }
+
+  auto count() const -> size_t {
+    return Kernels::popcount(words.data(), words.size());
+  }
 
-  constexpr Value(bool value, size_t size) : data(size) {
-    for (size_t i=0; i<size; i++) {
-      data[i] = value;
+  // NOTE: connectives such as negation and implication produce ones past the last row,
+  //       this restores the invariant that the unused bits are zero.
+  constexpr auto clearPadding() -> void {
+    auto remainder = size % WORD_BITS;
+    if (remainder != 0) {
+      words.back() &= (Word(1) << remainder) - 1;
     }
   }
 
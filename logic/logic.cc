@@ -2,47 +2,344 @@
 #include "logic/logic.h"
 #include "evaluation/environment.h"
 #include "logic/parsing/parser.h"
+#include "logic/parsing/simplifier.h"
+#include "logic/parsing/splitter.h"
+#include "logic/solver/prover.h"
 #include "logic/utils/overloaded.h"
 #include "logic/utils/color.h"
+#include "logic/utils/lineIndex.h"
+#include "logic/utils/mappedFile.h"
+#include "logic/utils/output.h"
+#include "logic/utils/profiler.h"
 #include "logic/utils/utils.h"
 
+#include <atomic>
 #include <cctype>
-#include <fstream>
-#include <sstream>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 
 #include <utility>
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace logic;
 
+namespace {
+
+auto countNodes(const Sentence& sentence) -> size_t {
+  size_t nodes = 0;
+  Sentence::walk(sentence, [&](const Sentence&) { nodes++; });
+  return nodes;
+}
+
+}
+
+Logic::Logic(Options options) : mOptions(options) {
+  if (mOptions.jobs > 1) {
+    mPool = std::make_unique<ThreadPool>(mOptions.jobs);
+  }
+
+  if (mOptions.dimacs) {
+    mDimacs = *mOptions.dimacs == "-" ? stdout : std::fopen(std::string(*mOptions.dimacs).c_str(), "w");
+    if (mDimacs == nullptr) {
+      fmt::println(stderr, "{}: Cannot write to `{}`", Color::Blue("LOGIC"), Color::Yellow(*mOptions.dimacs));
+      exit(1);
+    }
+  }
+
+  if (mOptions.trace) {
+    mTrace = std::fopen(std::string(*mOptions.trace).c_str(), "w");
+    if (mTrace == nullptr) {
+      fmt::println(stderr, "{}: Cannot write to `{}`", Color::Blue("LOGIC"), Color::Yellow(*mOptions.trace));
+      exit(1);
+    }
+  }
+  Profiler::start(mOptions.stats, mTrace);
+}
+
+Logic::~Logic() {
+  Profiler::stop();
+  if (mTrace != nullptr) {
+    std::fclose(mTrace);
+  }
+  if (mDimacs != nullptr and mDimacs != stdout) {
+    std::fclose(mDimacs);
+  }
+}
 
 auto Logic::run(std::string_view source, Environment& environment, std::string_view filename) -> void {
-  auto scanner = Scanner(source, filename);
-  auto tokens = scanner.scan();
+  const auto lines = LineIndex(source);
+  auto sentences = parse(Shard(source, 1), lines, filename);
+  if (not sentences.has_value()) return;
 
-  if (not tokens.has_value()) {
-    Logic::report(tokens.error(), source);
-    return;
+  for (const auto& sentence : *sentences) {
+    if (not runSentence(sentence, environment, lines, mPool.get())) return;
   }
+}
+
+auto Logic::parse(Shard shard, const LineIndex& lines, std::string_view filename) -> std::optional<std::vector<Sentence>> {
+  // NOTE: the lines with a scanner error are left out, the rest is still parsed to find its errors.
+  auto scanner = Scanner(shard.source, filename, shard.line);
+  auto tokens = [&] {
+    auto span = Profiler::Span(Profiler::Phase::Scan);
+    auto tokens = scanner.scan();
+    if (not tokens.has_value()) return std::move(scanner.tokens());
+    span.nodes(tokens->size());
+    return std::move(*tokens);
+  }();
 
-  auto parser = Parser(std::move(*tokens));
+  auto span = Profiler::Span(Profiler::Phase::Parse);
+  auto parser = Parser(std::move(tokens));
   auto sentences = parser.parse();
 
-  if (not sentences.has_value()) {
-    Logic::report(sentences.error(), source);
-    return;
+  if (not scanner.errors().empty() or not sentences.has_value()) {
+    // the errors of both are in source order, they are merged so that they are reported in line order.
+    const auto before = [](SourceLocation a, SourceLocation b) {
+      return std::pair(a.line, a.start) < std::pair(b.line, b.start);
+    };
+    const auto locate = [](const auto& error) { return error.accept([](const auto& e) { return e.location; }); };
+
+    const auto& scannerErrors = scanner.errors();
+    const auto& parserErrors = parser.errors();
+    size_t i = 0, j = 0;
+    while (i < scannerErrors.size() or j < parserErrors.size()) {
+      if (j == parserErrors.size() or (i < scannerErrors.size() and before(locate(scannerErrors[i]), locate(parserErrors[j])))) {
+        Logic::report(scannerErrors[i++], lines);
+      } else {
+        Logic::report(parserErrors[j++], lines);
+      }
+    }
+    return std::nullopt;
+  }
+  if (Profiler::enabled()) {
+    for (const auto& sentence : *sentences) span.nodes(countNodes(sentence));
   }
+  return std::move(*sentences);
+}
 
-  for (const auto& sentence : *sentences) {
-    auto evaluator = Evaluator(environment);
-    auto value = evaluator.evaluate(sentence);
-    if (not value.has_value()) {
-      Logic::report(value.error(), source);
-      return;
+auto Logic::runSentence(const Sentence& original, Environment& environment, const LineIndex& lines, ThreadPool* pool) -> bool {
+  auto span = Profiler::Span(Profiler::Phase::Sentence);
+  span.name([&] { return Sentence::asString(original); });
+
+  auto simplified = std::optional<Sentence>();
+  if (mOptions.simplify and Simplifier::isSimplifiable(original)) {
+    auto simplifySpan = Profiler::Span(Profiler::Phase::Simplify);
+    simplified = Simplifier::simplify(original);
+    if (Profiler::enabled()) simplifySpan.nodes(Simplifier::size(original) - Simplifier::size(*simplified));
+
+    if (mOptions.showSimplified) {
+      fmt::println(Output::err(), "{} {} {}", Color::Yellow(Sentence::asString(original)), Color::Blue("⟶"),
+                   Color::Yellow(Sentence::asString(*simplified)));
+    }
+  }
+  const auto& sentence = simplified ? *simplified : original;
+
+  if (sentence.is<Sentence::Query>()) {
+    fmt::println(Output::err(), "{}", Color::Yellow(Sentence::asString(sentence)));
+    auto prover = Prover(environment, mOptions.backend);
+    auto proveSpan = Profiler::Span(Profiler::Phase::Prove);
+
+    if (mDimacs != nullptr) {
+      auto exported = prover.exportDimacs(sentence.unsafeAsRef<Sentence::Query>(), mDimacs);
+      if (not exported.has_value()) {
+        Logic::report(exported.error(), lines);
+        return false;
+      }
+      return true;
+    }
+
+    auto answer = prover.prove(sentence.unsafeAsRef<Sentence::Query>());
+    if (not answer.has_value()) {
+      Logic::report(answer.error(), lines);
+      return false;
+    }
+    Prover::print(*answer);
+    return true;
+  }
+
+  auto evaluator = Evaluator(environment, pool, mOptions.format, &mCache);
+  if (simplified) {
+    auto declared = evaluator.declare(original);
+    if (not declared.has_value()) {
+      Logic::report(declared.error(), lines);
+      return false;
     }
+  }
 
-    evaluator.printEvaluation();
+  if (mOptions.classify) {
+    // NOTE: an assignment is only applied, it has no table of its own to classify.
+    if (Sentence::hasAssignment(sentence)) {
+      auto declared = evaluator.declare(sentence);
+      if (not declared.has_value()) {
+        Logic::report(declared.error(), lines);
+        return false;
+      }
+      return true;
+    }
+
+    auto classification = evaluator.classify(sentence);
+    if (not classification.has_value()) {
+      Logic::report(classification.error(), lines);
+      return false;
+    }
+    Evaluator::print(*classification);
+    return true;
   }
+
+  // NOTE: a sentence that simplified to a single variable or constant has no column of its own, its
+  //       result is shown under the original sentence.
+  const auto label = simplified ? Sentence::asString(original) : std::string();
+  auto value = evaluator.stream(sentence, label);
+  if (not value.has_value()) {
+    Logic::report(value.error(), lines);
+    return false;
+  }
+  return true;
+}
+
+auto Logic::runBatch(std::string_view source, std::string_view filename) -> void {
+  struct Parsed {
+    std::optional<std::vector<Sentence>> sentences;
+    // the syntax errors of the shard, only reported when a shard failed to parse.
+    std::unique_ptr<char, decltype(&std::free)> err = {nullptr, &std::free};
+    size_t errSize = 0;
+  };
+
+  struct Slot {
+    Environment environment;
+    std::unique_ptr<char, decltype(&std::free)> out = {nullptr, &std::free};
+    std::unique_ptr<char, decltype(&std::free)> err = {nullptr, &std::free};
+    // where the output of every sentence ends in `out` and `err`, the last one is the whole output.
+    std::vector<std::pair<size_t, size_t>> ends;
+    bool failed = false;
+    std::atomic<bool> ready = false;
+  };
+
+  // NOTE: the output of every sentence only has to be interleaved with its diagnostics when both
+  //       go to the same place, otherwise each shard is written with one call per stream.
+  const auto interleave = [] {
+    struct stat out, err;
+    if (::fstat(STDOUT_FILENO, &out) != 0 or ::fstat(STDERR_FILENO, &err) != 0) return true;
+    return out.st_dev == err.st_dev and out.st_ino == err.st_ino;
+  }();
+
+  const auto shards = splitShards(source, BATCH_SHARD_BYTES);
+  const auto lines = LineIndex(source);
+
+  // NOTE: like `run`, nothing is evaluated when the source has a syntax error. Every shard is parsed
+  //       first so that the errors of all of them are reported, in line order since shards are.
+  auto parsed = std::vector<Parsed>(shards.size());
+  for (size_t index = 0; index < shards.size(); index++) {
+    mPool->submit([&, index] {
+      char* err = nullptr;
+      size_t errSize = 0;
+      auto* errFile = open_memstream(&err, &errSize);
+      {
+        auto redirect = Output::Redirect(Output::out(), errFile);
+        parsed[index].sentences = parse(shards[index], lines, filename);
+      }
+      std::fclose(errFile);
+      parsed[index].err.reset(err);
+      parsed[index].errSize = errSize;
+    });
+  }
+  mPool->wait();
+
+  bool failed = false;
+  for (const auto& shard : parsed) {
+    if (shard.sentences.has_value()) continue;
+    std::fwrite(shard.err.get(), 1, shard.errSize, Output::err());
+    failed = true;
+  }
+  if (failed) return;
+
+  const auto window = std::min<size_t>(2 * mPool->size(), shards.size());
+  auto slots = std::vector<Slot>(window);
+
+  // NOTE: assignments are the only state shared between sentences. The environment a shard starts
+  //       with is found by applying the assignments of the shards before it, which is only needed for
+  //       the shards that contain an assignment at all. Any error is left to the worker to report.
+  auto environment = Environment();
+  bool stopped = false;
+  const auto assignments = [&](size_t index) -> bool {
+    if (shards[index].source.find('=') == std::string_view::npos) return true;
+
+    for (const auto& sentence : *parsed[index].sentences) {
+      if (not Sentence::hasAssignment(sentence)) continue;
+      if (not Evaluator(environment).declare(sentence).has_value()) return false;
+    }
+    return true;
+  };
+
+  const auto worker = [&, this](size_t index, Slot& slot) {
+    char* out = nullptr;
+    char* err = nullptr;
+    size_t outSize = 0, errSize = 0;
+    auto* outFile = open_memstream(&out, &outSize);
+    auto* errFile = open_memstream(&err, &errSize);
+
+    {
+      auto redirect = Output::Redirect(outFile, errFile);
+      slot.ends.clear();
+      slot.failed = false;
+
+      const auto& sentences = *parsed[index].sentences;
+      for (size_t i = 0; not slot.failed and i < sentences.size(); i++) {
+        // NOTE: the shards already use every worker, so the blocks of a table are not split further.
+        slot.failed = not runSentence(sentences[i], slot.environment, lines, nullptr);
+        std::fflush(outFile);
+        std::fflush(errFile);
+        slot.ends.emplace_back(outSize, errSize);
+      }
+    }
+
+    std::fclose(outFile);
+    std::fclose(errFile);
+    slot.out.reset(out);
+    slot.err.reset(err);
+    slot.ends.emplace_back(outSize, errSize);
+
+    slot.ready = true;
+    slot.ready.notify_one();
+  };
+
+  const auto schedule = [&](size_t index) {
+    auto& slot = slots[index % window];
+    slot.environment = environment;
+    slot.ready = false;
+    stopped = not assignments(index);
+    mPool->submit([&, index] { worker(index, slots[index % window]); });
+  };
+
+  size_t scheduled = 0;
+  for (; scheduled < window and not stopped; scheduled++) {
+    schedule(scheduled);
+  }
+
+  for (size_t index = 0; index < scheduled; index++) {
+    auto& slot = slots[index % window];
+    slot.ready.wait(false);
+
+    size_t out = 0, err = 0;
+    for (size_t i = 0; i < slot.ends.size(); i++) {
+      if (not interleave and i + 1 < slot.ends.size()) continue;
+      const auto [outEnd, errEnd] = slot.ends[i];
+      std::fwrite(slot.err.get() + err, 1, errEnd - err, Output::err());
+      std::fwrite(slot.out.get() + out, 1, outEnd - out, Output::out());
+      out = outEnd;
+      err = errEnd;
+    }
+
+    if (slot.failed) break;
+    if (scheduled < shards.size() and not stopped) {
+      schedule(scheduled++);
+    }
+  }
+
+  // NOTE: after an error the shards that are still running write to slots that are about to go away.
+  mPool->wait();
 }
 
 auto Logic::runREPL() -> void {
@@ -55,31 +352,31 @@ auto Logic::runREPL() -> void {
     if (not std::getline(std::cin, source)) { break; }
 
     run(source, environment, "REPL");
+    if (mOptions.stats) Profiler::report(stderr);
   }
 }
 
 auto Logic::runFile(std::string_view filename) -> void {
-  std::ifstream file(filename);
-  std::stringstream source;
+  auto file = MappedFile::open(filename);
 
-  if (file.fail()) {
+  if (not file.has_value()) {
     fmt::println(stderr, "{}: File `{}` does not exist", Color::Blue("LOGIC"), Color::Yellow(filename));
     exit(1);
   }
 
-  if (file.is_open()) {
-    std::string line;
-    while (file) {
-      std::getline(file, line);
-      source << line << "\n";
-    }
+  // NOTE: tokens are views into the mapping, which outlives them since it is only released here.
+  // NOTE: queries that export DIMACS all write to the same file, so they are not run in batches.
+  if (mOptions.batch and mPool != nullptr and mDimacs == nullptr) {
+    runBatch(file->contents(), filename);
+  } else {
+    Environment environment;
+    run(file->contents(), environment, filename);
   }
 
-  Environment environment;
-  run(source.str(), environment, filename);
+  if (mOptions.stats) Profiler::report(stderr);
 }
 
-auto Logic::report(const ParserError& e, std::string_view source) -> void {
+auto Logic::report(const ParserError& e, const LineIndex& lines) -> void {
   auto location = e.accept([](auto& error){return error.location;}) ;
   auto message = e.accept(overloaded{
       [](const ParserError::UnexpectedToken &e) {
@@ -89,10 +386,10 @@ auto Logic::report(const ParserError& e, std::string_view source) -> void {
       [](const ParserError::ExpectedSentence &e) {
         return fmt::format("Expected sentence about here.");
       }});
-  reportInternal(message, location, source);
+  reportInternal(message, location, lines);
 }
 
-auto Logic::report(const ScannerError& e, std::string_view source) -> void {
+auto Logic::report(const ScannerError& e, const LineIndex& lines) -> void {
   auto location = e.accept([](auto& error){return error.location;}) ;
   auto message = e.accept(overloaded {
     [](const ScannerError::UnexpectedKeyword &e) {
@@ -102,17 +399,17 @@ auto Logic::report(const ScannerError& e, std::string_view source) -> void {
       return fmt::format("The keyword `{}` is not capitalized correctly. It should be `{}`.", e.keyword, stringToUpper(e.keyword));
     },
     [](const ScannerError::InvalidVariableName &e) {
-      return fmt::format("Invalid variable name `{}`. Variables must have length 1", e.name);
+      return fmt::format("Invalid variable name `{}`. Variables must be a single letter, optionally followed by digits", e.name);
     },
     [](const ScannerError::UnexpectedCharacter &e) {
       return fmt::format("Unexpected character `{}`", e.character);
     }
   });
 
-  reportInternal(message, location, source);
+  reportInternal(message, location, lines);
 }
 
-auto Logic::report(const EvaluatorError& e, std::string_view source) -> void {
+auto Logic::report(const EvaluatorError& e, const LineIndex& lines) -> void {
   auto location = e.accept([](auto& error){return error.location;}) ;
   auto message = e.accept(overloaded{
       [](const EvaluatorError::MaximumVariablesAchieved &e) -> std::string {
@@ -123,21 +420,11 @@ auto Logic::report(const EvaluatorError& e, std::string_view source) -> void {
                "variable and the right-hand side is either TRUE or FALSE.";
       },
   });
-  reportInternal(message, location, source);
+  reportInternal(message, location, lines);
 }
 
 
-auto Logic::reportInternal(std::string_view message, SourceLocation location, std::string_view source) -> void {
-  static constexpr auto getNthLine = [](std::string_view inputString, int nthLine) -> std::string {
-    std::string input(inputString);
-    std::istringstream iss(input);
-    std::string line;
-    int currentLine = 0;
-    while (currentLine < nthLine and std::getline(iss, line)) {
-      ++currentLine;
-    }
-    return (currentLine == nthLine) ? line : "";
-  };
+auto Logic::reportInternal(std::string_view message, SourceLocation location, const LineIndex& lines) -> void {
   static constexpr auto leftPad = [](std::string_view string, size_t length) -> std::string {
     return fmt::format("{}{}", std::string(length, ' '), string);
   };
@@ -156,8 +443,8 @@ auto Logic::reportInternal(std::string_view message, SourceLocation location, st
   auto line = Color::Blue("|");
   auto lineNumber = Color::Blue(location.line);
 
-  fmt::println(stderr, "{} {}", padding, line);
-  fmt::println(stderr, "{} {} {}", lineNumber, line, getNthLine(source, location.line));
-  fmt::println(stderr, "{} {} {}", padding, line, Color::Red(arrows));
-  fmt::println(stderr, "{} {}", Color::Yellow("ERROR:"), message);
+  fmt::println(Output::err(), "{} {}", padding, line);
+  fmt::println(Output::err(), "{} {} {}", lineNumber, line, lines.line(location.line));
+  fmt::println(Output::err(), "{} {} {}", padding, line, Color::Red(arrows));
+  fmt::println(Output::err(), "{} {}", Color::Yellow("ERROR:"), message);
 }
@@ -1,20 +1,59 @@
-
 #include <logic/parsing/parser.h>
 #include <logic/parsing/scanner.h>
+#include <logic/parsing/splitter.h>
+#include <logic/evaluation/columnCache.h>
 #include <logic/evaluation/evaluator.h>
+#include <logic/utils/lineIndex.h>
+#include <logic/utils/threadPool.h>
+#include <logic/options.h>
+
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <vector>
 
 using namespace logic;
 
 class Logic {
 
 public:
-  static auto runFile(std::string_view filename) -> void;
-  static auto runREPL() -> void;
+  explicit Logic(Options options);
+  ~Logic();
+
+  Logic(const Logic&) = delete;
+  auto operator=(const Logic&) -> Logic& = delete;
+
+  auto runFile(std::string_view filename) -> void;
+  auto runREPL() -> void;
 
 private:
-  static auto run(std::string_view source, Environment& env, std::string_view filename) -> void;
-  static auto report(const EvaluatorError&, std::string_view) -> void;
-  static auto report(const ScannerError&, std::string_view) -> void;
-  static auto report(const ParserError&, std::string_view) -> void;
-  static auto reportInternal(std::string_view message, SourceLocation location, std::string_view source) -> void;
+  // Batch mode splits the source into shards of about this size, see `runBatch`.
+  static constexpr size_t BATCH_SHARD_BYTES = 1 << 16;
+
+  Options mOptions;
+  std::unique_ptr<ThreadPool> mPool;
+  // columns of sub-sentences shared across the sentences of a run, see `ColumnCache`.
+  ColumnCache mCache;
+  // where queries write their CNF when `--dimacs` is given, instead of being solved.
+  std::FILE* mDimacs = nullptr;
+  // where `--trace` writes the trace events of the run, see `Profiler`.
+  std::FILE* mTrace = nullptr;
+
+  auto run(std::string_view source, Environment& env, std::string_view filename) -> void;
+  // Scans, parses and runs shards of the source on the thread pool, the output of every shard is
+  // collected by its worker and printed in source order. Like `run`, every shard is parsed before
+  // anything is run, so a syntax error anywhere reports every syntax error and runs nothing.
+  auto runBatch(std::string_view source, std::string_view filename) -> void;
+
+  // Errors are reported against `lines`, the lines of the whole source the shard is part of. Every
+  // syntax error of the shard is reported in line order, see `Scanner::scan` and `Parser::parse`.
+  auto parse(Shard, const LineIndex& lines, std::string_view filename) -> std::optional<std::vector<Sentence>>;
+  // With `--simplify` the sentence is simplified first, a truth table still has a row for every
+  // assignment of the variables of the original sentence. With `--classify` only the kind of the
+  // sentence is printed, see `Evaluator::classify`, and assignments are only applied.
+  auto runSentence(const Sentence&, Environment&, const LineIndex& lines, ThreadPool*) -> bool;
+  static auto report(const EvaluatorError&, const LineIndex&) -> void;
+  static auto report(const ScannerError&, const LineIndex&) -> void;
+  static auto report(const ParserError&, const LineIndex&) -> void;
+  static auto reportInternal(std::string_view message, SourceLocation location, const LineIndex& lines) -> void;
 };
@@ -1,17 +1,29 @@
 #include <fmt/core.h>
 
 #include "logic/logic.h"
+#include "logic/options.h"
 #include "logic/utils/color.h"
 
 using namespace logic;
 
 auto main(int argc, const char** argv) -> int {
 
-  if (argc == 1) {
-    Logic::runREPL();
-  } else if (argc == 2) {
-    Logic::runFile(argv[1]);
+  auto options = Options::parse(argc, argv);
+  if (not options.has_value()) {
+    fmt::println(stderr, "{}: {}", Color::Blue("Logic"), options.error());
+    fmt::println(stderr, "{}: usage {}", Color::Blue("Logic"), Color::Yellow("[--kernel=scalar|avx2|avx512] [--jobs=N] [--batch] [--backend=sat|bdd] [--format=table|csv|jsonl|bin] [--dimacs=FILE|-] [--simplify[=show]] [--classify] [--stats] [--trace=FILE] <source>"));
+    return 1;
+  }
+
+  if (options->kernel and not Kernels::force(*options->kernel)) {
+    fmt::println(stderr, "{}: the `{}` kernels are not supported by this CPU", Color::Blue("Logic"), Kernels::levelToString(*options->kernel));
+    return 1;
+  }
+
+  auto logic = Logic(*options);
+  if (options->filename) {
+    logic.runFile(*options->filename);
   } else {
-    fmt::println(stderr, "{}: usage {}", Color::Blue("Logic"), Color::Yellow("<source>"));
+    logic.runREPL();
   }
 }
@@ -0,0 +1,116 @@
+#include "logic/options.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <charconv>
+#include <thread>
+
+using namespace logic;
+
+auto Options::parse(int argc, const char** argv) -> std::expected<Options, std::string> {
+  static constexpr auto valueOf = [](std::string_view argument, std::string_view flag) -> std::optional<std::string_view> {
+    if (not argument.starts_with(flag) or argument.size() <= flag.size() or argument[flag.size()] != '=') {
+      return std::nullopt;
+    }
+    return argument.substr(flag.size() + 1);
+  };
+
+  static constexpr auto parseNumber = [](std::string_view value) -> std::optional<size_t> {
+    size_t number = 0;
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (error != std::errc() or end != value.data() + value.size()) {
+      return std::nullopt;
+    }
+    return number;
+  };
+
+  auto options = Options {};
+  for (auto i = 1; i < argc; i++) {
+    auto argument = std::string_view(argv[i]);
+
+    if (auto value = valueOf(argument, "--kernel")) {
+      options.kernel = Kernels::levelFromString(*value);
+      if (not options.kernel) {
+        return std::unexpected(fmt::format("Unknown kernel `{}`, expected one of scalar, avx2 or avx512", *value));
+      }
+      continue;
+    }
+
+    if (auto value = valueOf(argument, "--jobs")) {
+      auto jobs = parseNumber(*value);
+      if (not jobs) {
+        return std::unexpected(fmt::format("Invalid number of jobs `{}`", *value));
+      }
+      // NOTE: `--jobs=0` uses every available core.
+      options.jobs = *jobs == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : *jobs;
+      continue;
+    }
+
+    if (argument == "--batch") {
+      options.batch = true;
+      continue;
+    }
+
+    if (auto value = valueOf(argument, "--backend")) {
+      auto backend = Prover::backendFromString(*value);
+      if (not backend) {
+        return std::unexpected(fmt::format("Unknown backend `{}`, expected one of sat or bdd", *value));
+      }
+      options.backend = *backend;
+      continue;
+    }
+
+    if (auto value = valueOf(argument, "--format")) {
+      auto format = StreamingTable::formatFromString(*value);
+      if (not format) {
+        return std::unexpected(fmt::format("Unknown format `{}`, expected one of table, csv, jsonl or bin", *value));
+      }
+      options.format = *format;
+      continue;
+    }
+
+    if (auto value = valueOf(argument, "--dimacs")) {
+      options.dimacs = *value;
+      continue;
+    }
+
+    if (argument == "--simplify") {
+      options.simplify = true;
+      continue;
+    }
+
+    if (auto value = valueOf(argument, "--simplify")) {
+      if (*value != "show") {
+        return std::unexpected(fmt::format("Unknown simplify mode `{}`, expected show", *value));
+      }
+      options.simplify = true;
+      options.showSimplified = true;
+      continue;
+    }
+
+    if (argument == "--classify") {
+      options.classify = true;
+      continue;
+    }
+
+    if (argument == "--stats") {
+      options.stats = true;
+      continue;
+    }
+
+    if (auto value = valueOf(argument, "--trace")) {
+      options.trace = *value;
+      continue;
+    }
+
+    if (argument.starts_with("--")) {
+      return std::unexpected(fmt::format("Unknown option `{}`", argument));
+    }
+    if (options.filename) {
+      return std::unexpected(fmt::format("Unexpected argument `{}`, only one source file is supported", argument));
+    }
+    options.filename = argument;
+  }
+  return options;
+}
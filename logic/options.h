@@ -0,0 +1,37 @@
+#pragma once
+
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "logic/evaluation/kernels.h"
+#include "logic/solver/prover.h"
+#include "logic/utils/table.h"
+
+namespace logic {
+
+struct Options {
+  std::optional<std::string_view> filename;
+  std::optional<Kernels::Level> kernel;
+  size_t jobs = 1;
+  // runs the sentences of a file in shards on `jobs` threads, see `Logic::runBatch`.
+  bool batch = false;
+  Prover::Backend backend = Prover::Backend::Sat;
+  StreamingTable::Format format = StreamingTable::Format::Table;
+  // `-` is the standard output.
+  std::optional<std::string_view> dimacs;
+  // prints the time, allocations, rows and nodes of every phase, see `Profiler`.
+  bool stats = false;
+  // where the Chrome trace events of every sentence and phase are written.
+  std::optional<std::string_view> trace;
+  // rewrites sentences before running them, see `Simplifier`, and shows both forms with `--simplify=show`.
+  bool simplify = false;
+  bool showSimplified = false;
+  // reports whether every sentence is a tautology, a contradiction or contingent instead of printing its table.
+  bool classify = false;
+
+  static auto parse(int argc, const char** argv) -> std::expected<Options, std::string>;
+};
+
+}
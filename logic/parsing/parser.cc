@@ -2,90 +2,162 @@
 #include <logic/parsing/parser.h>
 #include <logic/utils/macros.h>
 
+#include <vector>
+
 using namespace logic;
 
 auto Parser::parse() -> std::expected<std::vector<Sentence>, ParserError> {
   auto sentences = std::vector<Sentence> {};
+  mErrors.clear();
   while (not isAtEnd()) {
-    auto sentence = TRY(parseSentence());
-    sentences.push_back(std::move(sentence));
+    const auto start = mCurrent;
+    auto sentence = parseSentence();
+    if (not sentence.has_value()) {
+      mErrors.push_back(std::move(sentence.error()));
+      synchronize(start);
+      continue;
+    }
+    sentences.push_back(std::move(*sentence));
+  }
+
+  if (not mErrors.empty()) {
+    return std::unexpected(mErrors.front());
   }
   return sentences;
 }
 
+// Skips the rest of a sentence with an error, which started at the token `start`, up to where the
+// next sentence can start. The token the error is at is kept when it starts a sentence on a line of
+// its own, the sentence before it is most likely just missing a `)`.
+auto Parser::synchronize(size_t start) -> void {
+  if (mCurrent == start or not isSynchronized()) {
+    advance();
+  }
+  while (not isAtEnd() and not isSynchronized()) {
+    advance();
+  }
+}
+
+// Whether a sentence can start at the current token: a query keyword always starts one, and any other
+// token that can start a sentence only does at the start of a line.
+constexpr auto Parser::isSynchronized() const -> bool {
+  switch (peek().type) {
+    case TokenType::Sat:
+    case TokenType::Valid:
+    case TokenType::Count:
+      return true;
+    case TokenType::Variable:
+    case TokenType::True:
+    case TokenType::False:
+    case TokenType::Not:
+    case TokenType::LeftParen:
+      return peekPrevious().location.line < peek().location.line;
+    default:
+      return false;
+  }
+}
+
 auto Parser::parseSentence() -> std::expected<Sentence, ParserError> {
+  if (match({TokenType::Sat, TokenType::Valid, TokenType::Count})) {
+    return parseQuerySentence();
+  }
   return parseCompoundSentence();
 }
 
-auto Parser::parseCompoundSentence() -> std::expected<Sentence, ParserError> {
-  auto lhs = TRY(parsePrimary());
-  return parseBinaryRHS(0, std::move(lhs));
+auto Parser::parseQuerySentence() -> std::expected<Sentence, ParserError> {
+  auto keyword = peekPrevious();
+  auto sentence = TRY(parseCompoundSentence());
+  return Sentence::Query(keyword, std::move(sentence));
 }
 
-auto Parser::parseGroupedSentence() -> std::expected<Sentence, ParserError> {
-  auto sentence = TRY(parseSentence());
-  if (not match(TokenType::RightParen)) {
-    return std::unexpected(ParserError::UnexpectedToken(TokenType::RightParen, peek(), getCurrentLocation()));
+constexpr auto Parser::getTokenPrecedence(TokenType type) -> int {
+  switch (type) {
+    case TokenType::Equal:
+      return 10;
+    case TokenType::Equivalent:
+      return 20;
+    case TokenType::Implies:
+      return 30;
+    case TokenType::Or:
+      return 40;
+    case TokenType::And:
+      return 50;
+    default:
+      return -1;
   }
-  return Sentence::Grouped(std::move(sentence));
 }
 
+// Parses operators by precedence with explicit stacks of operands and pending operators instead of
+// recursing for every operator, negation and parenthesis, so that machine generated sentences nested
+// arbitrarily deep do not overflow the stack.
+auto Parser::parseCompoundSentence() -> std::expected<Sentence, ParserError> {
+  // NOTE: a pending `(` or `¬` has no operand yet, a pending connective has its left operand on the stack.
+  struct Pending {
+    Token token;
+    int precedence;
+  };
 
-auto Parser::parsePrimary() -> std::expected<Sentence, ParserError> {
-  if (match(TokenType::LeftParen)) {
-    return parseGroupedSentence();
-  }
-  if (match(TokenType::Not)) {
-    return parseNegatedSentence();
-  }
+  auto operands = std::vector<Sentence>();
+  auto pending = std::vector<Pending>();
 
-  return parseAtomicSentence();
-}
+  const auto reduce = [&] {
+    auto rhs = std::move(operands.back());
+    operands.pop_back();
+    auto lhs = std::move(operands.back());
+    operands.pop_back();
+    operands.emplace_back(Sentence::Compound(pending.back().token, std::move(lhs), std::move(rhs)));
+    pending.pop_back();
+  };
 
-auto Parser::parseBinaryRHS(int prevPrec, Sentence lhs) -> std::expected<Sentence, ParserError> {
-  constexpr static auto getTokenPrecedence = [](TokenType type) -> int {
-    switch (type) {
-      case TokenType::Equal:
-        return 10;
-      case TokenType::Equivalent:
-        return 20;
-      case TokenType::Implies:
-        return 30;
-      case TokenType::Or:
-        return 40;
-      case TokenType::And:
-        return 50;
-      default:
-        return -1;
+  // NOTE: `¬` binds to the primary right after it, so it is applied as soon as that primary is complete.
+  const auto negate = [&] {
+    while (not pending.empty() and pending.back().token.type == TokenType::Not) {
+      auto operand = std::move(operands.back());
+      operands.pop_back();
+      operands.emplace_back(Sentence::Negated(std::move(operand)));
+      pending.pop_back();
     }
   };
 
   while (true) {
-    auto tokenPrec = getTokenPrecedence(peek().type);
-    if (tokenPrec < prevPrec) {
-      return lhs;
+    // NOTE: queries are only allowed at the start of a statement, not after a `(`.
+    while (match({TokenType::LeftParen, TokenType::Not})) {
+      pending.emplace_back(peekPrevious(), -1);
     }
-
-    auto binOp = advance();
-    auto rhs = TRY(parsePrimary());
-
-    auto nextPrec = getTokenPrecedence(peek().type);
-    if (tokenPrec <= nextPrec) {
-      // NOTE: We prefer right associativity so we subtract 1 to the 'tokenPrec' which is the
-      //       current operator precedence, and prefer the other precedence.
-      //       This is needed since '=>' and '<=>' are right associative.
-      rhs = TRY(parseBinaryRHS(tokenPrec-1, std::move(rhs)));
+    auto atomic = TRY(parseAtomicSentence());
+    operands.push_back(std::move(atomic));
+    negate();
+
+    while (true) {
+      const auto precedence = getTokenPrecedence(peek().type);
+      if (precedence >= 0) {
+        // NOTE: every connective is right associative, so only the ones that bind tighter are reduced.
+        while (not pending.empty() and pending.back().precedence > precedence) {
+          reduce();
+        }
+        pending.emplace_back(advance(), precedence);
+        break;
+      }
+
+      while (not pending.empty() and pending.back().precedence >= 0) {
+        reduce();
+      }
+      if (pending.empty()) {
+        return std::move(operands.back());
+      }
+
+      if (not match(TokenType::RightParen)) {
+        return std::unexpected(ParserError::UnexpectedToken(TokenType::RightParen, peek(), getCurrentLocation()));
+      }
+      auto sentence = std::move(operands.back());
+      operands.pop_back();
+      operands.emplace_back(Sentence::Grouped(std::move(sentence)));
+      pending.pop_back();
+      negate();
     }
-
-    lhs = Sentence::Compound(binOp, std::move(lhs), std::move(rhs));
   }
 }
 
-auto Parser::parseNegatedSentence() -> std::expected<Sentence, ParserError> {
-  auto sentence = TRY(parsePrimary());
-  return Sentence::Negated(std::move(sentence));
-}
-
 auto Parser::parseAtomicSentence() -> std::expected<Sentence, ParserError> {
 
   if (match({TokenType::True, TokenType::False})) {
@@ -48,25 +48,32 @@ class Parser {
 
   size_t mCurrent = 0;
   std::vector<Token> mTokens;
+  std::vector<ParserError> mErrors;
 
 public:
   constexpr Parser(std::vector<Token> tokens) 
     : mTokens(std::move(tokens)) {}
 
+  // Parsing goes on after an error, see `synchronize`, so that one pass finds every error of the
+  // source. The first one is returned, all of them are kept in `errors`.
   auto parse() -> std::expected<std::vector<Sentence>, ParserError>;
 
+  constexpr auto errors() const -> const std::vector<ParserError>& {
+    return mErrors;
+  }
+
 private:
   auto parseSentence() -> std::expected<Sentence, ParserError>;
   auto parseAssignmentSentence() -> std::expected<Sentence, ParserError>;
-
-  auto parseGroupedSentence() -> std::expected<Sentence, ParserError>;
+  auto parseQuerySentence() -> std::expected<Sentence, ParserError>;
 
   auto parseCompoundSentence() -> std::expected<Sentence, ParserError>;
-  auto parseNegatedSentence() -> std::expected<Sentence, ParserError>;
   auto parseAtomicSentence() -> std::expected<Sentence, ParserError>;
 
-  auto parseBinaryRHS(int, Sentence) -> std::expected<Sentence, ParserError>;
-  auto parsePrimary() -> std::expected<Sentence, ParserError>;
+  auto synchronize(size_t start) -> void;
+  constexpr auto isSynchronized() const -> bool;
+
+  static constexpr auto getTokenPrecedence(TokenType) -> int;
 
   constexpr auto getCurrentLocation() const -> SourceLocation;
   constexpr auto advance() -> const Token&;
@@ -2,36 +2,159 @@
 #include "logic/utils/macros.h"
 #include "logic/utils/utils.h"
 
-#include <ranges>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <optional>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace logic;
 
+namespace {
+
+struct Keyword {
+  std::string_view lexeme;
+  TokenType type;
+};
+
+constexpr auto KEYWORDS = std::to_array<Keyword>({
+  {"TRUE", TokenType::True},
+  {"FALSE", TokenType::False},
+  {"NOT", TokenType::Not},
+  {"AND", TokenType::And},
+  {"OR", TokenType::Or},
+  {"IMPLIES", TokenType::Implies},
+  {"EQUIVALENT", TokenType::Equivalent},
+  {"SAT", TokenType::Sat},
+  {"VALID", TokenType::Valid},
+  {"COUNT", TokenType::Count},
+});
+
+// NOTE: the length, first and last letter are enough to tell the keywords apart, the constants were
+//       found by a search and the static_assert below fails if a new keyword collides.
+constexpr auto keywordHash(std::string_view lexeme) -> size_t {
+  return (lexeme.length() + 2 * size_t(uint8_t(lexeme.front())) + size_t(uint8_t(lexeme.back()))) & 15;
+}
+
+constexpr auto KEYWORD_TABLE = [] {
+  auto table = std::array<std::optional<Keyword>, 16> {};
+  for (const auto& keyword : KEYWORDS) {
+    table[keywordHash(keyword.lexeme)] = keyword;
+  }
+  return table;
+}();
+
+// A single probe and one comparison, the lexeme is known to have at least two letters.
+constexpr auto lookupKeyword(std::string_view lexeme) -> std::optional<TokenType> {
+  const auto& slot = KEYWORD_TABLE[keywordHash(lexeme)];
+  if (slot and slot->lexeme == lexeme) return slot->type;
+  return std::nullopt;
+}
+
+static_assert(std::ranges::all_of(KEYWORDS, [](const Keyword& k) { return lookupKeyword(k.lexeme) == k.type; }));
+static_assert(not lookupKeyword("PQ") and not lookupKeyword("True") and not lookupKeyword("ORR"));
+
+// Only reached when a source is rejected, so the suggestion is not paid for by valid sources.
+[[gnu::cold, gnu::noinline]]
+auto keywordError(std::string_view lexeme, SourceLocation location) -> ScannerError {
+  if (lookupKeyword(stringToUpper(lexeme))) {
+    return ScannerError::InvalidKeywordFormat(lexeme, location);
+  }
+
+  auto suggestion = std::ranges::min_element(KEYWORDS, [&](const Keyword& a, const Keyword& b) {
+    return levenshteinDistance(lexeme, a.lexeme) < levenshteinDistance(lexeme, b.lexeme);
+  });
+  return ScannerError::UnexpectedKeyword(lexeme, suggestion->lexeme, location);
+}
+
+// Returns the length of the run of spaces, tabs and carriage returns at the start of `text`.
+auto blankRun(std::string_view text) -> size_t {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const auto space = _mm_set1_epi8(' ');
+  const auto tab = _mm_set1_epi8('\t');
+  const auto carriageReturn = _mm_set1_epi8('\r');
+  for (; i + 16 <= text.size(); i += 16) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+    const auto blank = _mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+                                    _mm_or_si128(_mm_cmpeq_epi8(chunk, tab), _mm_cmpeq_epi8(chunk, carriageReturn)));
+    const auto mask = uint32_t(_mm_movemask_epi8(blank));
+    if (mask != 0xFFFF) return i + std::countr_one(mask);
+  }
+#endif
+  while (i < text.size() and (text[i] == ' ' or text[i] == '\t' or text[i] == '\r')) i++;
+  return i;
+}
+
+}
+
 auto Scanner::scan() -> std::expected<std::vector<Token>, ScannerError> {
-  while (not isAtEnd()) {
+  mErrors.clear();
+  while (true) {
+    skipBlanks();
+    if (isAtEnd()) break;
     mStart = mCurrent;
     auto value = scanToken();
-    if (not value) { return std::unexpected(value.error()); }
+    if (not value) {
+      mErrors.push_back(std::move(value.error()));
+      synchronize();
+    }
+  }
+  // NOTE: the end of file is placed right after the last token, which is where a sentence that is cut
+  //       short is missing something, rather than on the empty line after the last newline.
+  if (mTokens.empty()) {
+    mStart = mCurrent = mLineStart;
+    addToken(TokenType::EndOfFile);
+  } else {
+    const auto last = mTokens.back().location;
+    mTokens.emplace_back(TokenType::EndOfFile, SourceLocation(last.end, last.end + 1, last.line, mFilename), "");
+  }
+
+  if (not mErrors.empty()) {
+    return std::unexpected(mErrors.front());
+  }
+  return std::move(mTokens);
+}
+
+// Drops the tokens of the line with an error and skips the rest of it. What is left of the line would
+// only make the parser report errors that are not there, the next line most likely starts a sentence.
+auto Scanner::synchronize() -> void {
+  while (not mTokens.empty() and mTokens.back().location.line == mLine) {
+    mTokens.pop_back();
+  }
+  const auto* newline = static_cast<const char*>(std::memchr(mSource.data() + mCurrent, '\n', mSource.size() - mCurrent));
+  mCurrent = newline ? size_t(newline - mSource.data()) : mSource.size();
+}
+
+auto Scanner::skipBlanks() -> void {
+  while (not isAtEnd()) {
+    mCurrent += blankRun(mSource.substr(mCurrent));
+    if (isAtEnd()) return;
+
+    switch (mSource[mCurrent]) {
+      case '\n':
+        mCurrent += 1;
+        mLineStart = mCurrent;
+        mLine += 1;
+        break;
+      case '#': {
+        const auto* newline = static_cast<const char*>(std::memchr(mSource.data() + mCurrent, '\n', mSource.size() - mCurrent));
+        mCurrent = newline ? size_t(newline - mSource.data()) : mSource.size();
+        break;
+      }
+      default:
+        return;
+    }
   }
-  addToken(TokenType::EndOfFile);
-  return mTokens;
 }
 
 auto Scanner::scanToken() -> std::expected<void, ScannerError> {
   auto c = advance();
   switch (c) {
-    case ' ':
-    case '\r':
-    case '\t':
-      break;
-    case '\n':
-      mLineStart = mCurrent;
-      mLine += 1;
-      break;
-    case '#':
-      while (peek() != '\n' and not isAtEnd()) {
-        advance();
-      };
-      break;
     case '=':
       addToken(TokenType::Equal);
       break;
@@ -59,53 +182,37 @@ auto Scanner::addToken(TokenType type) -> void {
 }
 
 auto Scanner::scanKeyword() -> std::expected<void, ScannerError> {
+  while (std::isalpha(peek())) {
+    advance();
+  }
 
-  static constexpr auto keywordLookup = [](std::string_view lexeme, SourceLocation location) 
-    -> std::expected<TokenType, ScannerError> {
-
-    if (lexeme.length() == 1) {
-      return TokenType::Variable;
-    }
-
-    auto keywords = {"TRUE", "FALSE",   "NOT",       "AND",
-                     "OR",   "IMPLIES", "EQUIVALENT"};
-    auto tokens = {TokenType::True,      TokenType::False, TokenType::Not,
-                   TokenType::And,       TokenType::Or,    TokenType::Implies,
-                   TokenType::Equivalent};
-
-    for (const auto& [keyword, tokenType] : std::views::zip(keywords, tokens)) {
-      if (keyword == lexeme) {
-        return tokenType;
-      }
+  // NOTE: a single letter may be followed by digits (e.g. `P12`), so queries can use more than 26 variables.
+  if (mCurrent - mStart == 1 and std::isdigit(peek())) {
+    while (std::isdigit(peek())) {
+      advance();
     }
-
-    for (const auto& keyword : keywords) {
-      if (stringToUpper(lexeme) == keyword) {
-          return std::unexpected(ScannerError::InvalidKeywordFormat(lexeme, location));
+    if (std::isalpha(peek())) {
+      while (std::isalnum(peek())) {
+        advance();
       }
+      return std::unexpected(ScannerError::InvalidVariableName(mSource.substr(mStart, mCurrent - mStart), getCurrentLocation()));
     }
-
-    auto suggestion = std::min_element(
-        keywords.begin(), keywords.end(),
-        [&](const std::string_view &a, const std::string_view &b) {
-          return levenshteinDistance(lexeme, a) <
-                 levenshteinDistance(lexeme, b);
-        });
-
-    return std::unexpected(ScannerError::UnexpectedKeyword(lexeme, *suggestion, location));
-  };
-
-  while (std::isalpha(peek())) {
-    advance();
+    addToken(TokenType::Variable);
+    return {};
   }
 
   auto lexeme = mSource.substr(mStart, mCurrent - mStart);
-  auto type = TRY(keywordLookup(lexeme, getCurrentLocation()));
-  if (lexeme.length() != 1 and type == TokenType::Variable) {
-    return std::unexpected(ScannerError::InvalidVariableName(lexeme, getCurrentLocation()));
+  if (lexeme.length() == 1) {
+    addToken(TokenType::Variable);
+    return {};
+  }
+
+  auto type = lookupKeyword(lexeme);
+  if (not type) {
+    return std::unexpected(keywordError(lexeme, getCurrentLocation()));
   }
 
-  addToken(type);
+  addToken(*type);
   return {};
 }
 
@@ -59,19 +59,35 @@ class Scanner {
   size_t mLine = 1;
   size_t mLineStart = 0;
   std::vector<Token> mTokens;
+  std::vector<ScannerError> mErrors;
 
   std::string_view mSource;
   std::string_view mFilename;
 
 public:
-  constexpr Scanner(std::string_view source, std::string_view filename="REPL") 
-    : mSource(source), mFilename(filename) {}
+  // NOTE: `firstLine` is the line the source starts at, for sources that are a slice of a larger file.
+  constexpr Scanner(std::string_view source, std::string_view filename="REPL", size_t firstLine = 1)
+    : mLine(firstLine), mSource(source), mFilename(filename) {}
 
+  // Scanning goes on from the next line after an error, see `synchronize`, so that one pass finds every
+  // error of the source. The first one is returned, all of them are kept in `errors` and the tokens of
+  // the other lines in `tokens`.
   auto scan() -> std::expected<std::vector<Token>, ScannerError>;
 
+  constexpr auto errors() const -> const std::vector<ScannerError>& {
+    return mErrors;
+  }
+
+  constexpr auto tokens() -> std::vector<Token>& {
+    return mTokens;
+  }
+
 private:
+  // Skips whitespace, newlines and comments in bulk, blanks are compared 16 bytes at a time.
+  auto skipBlanks() -> void;
   auto scanToken() -> std::expected<void, ScannerError>;
   auto scanKeyword() -> std::expected<void, ScannerError>;
+  auto synchronize() -> void;
 
   auto addToken(TokenType) -> void;
   auto match(char) -> bool;
@@ -3,55 +3,146 @@
 #include "logic/utils/overloaded.h"
 
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <fmt/core.h>
 
 using namespace logic;
 
-auto Sentence::asString(const Sentence& s) -> std::string {
-  return s.accept(overloaded {
-    [](const Sentence::Grouped& s) {
-      return fmt::format("({})", asString(*s.sentence));
-    },
-    [](const Sentence::Value& s) {
-      return fmt::format("{}", tokenTypeToString(s.value.type));
-    },
-    [](const Sentence::Negated& s) {
-      return fmt::format("¬{}", asString(*s.sentence));
-    },
-    [](const Sentence::Variable& s) {
-      return fmt::format("{}", s.identifier.lexeme);
-    },
-    [](const Sentence::Compound& s) {
-      auto right = asString(*s.right);
-      auto left = asString(*s.left);
-      if (s.right->is<Sentence::Compound>()) {
-        right = fmt::format("({})", right);
-      }
-      if (s.left->is<Sentence::Compound>()) {
-        left = fmt::format("({})", left);
+Sentence::~Sentence() {
+  // NOTE: the children would otherwise be destroyed recursively, one stack frame per level of nesting.
+  //       Every child is detached before it is destroyed, so none of their destructors recurse.
+  auto detached = std::vector<std::unique_ptr<Sentence>>();
+  detach(detached);
+  while (not detached.empty()) {
+    auto child = std::move(detached.back());
+    detached.pop_back();
+    child->detach(detached);
+  }
+}
+
+auto Sentence::detach(std::vector<std::unique_ptr<Sentence>>& detached) -> void {
+  const auto take = [&](std::unique_ptr<Sentence>& child) {
+    // NOTE: children that were moved out of a sentence by a rewriting pass are empty.
+    if (child != nullptr) detached.push_back(std::move(child));
+  };
+
+  std::visit(overloaded {
+    [&](Compound& s) { take(s.left); take(s.right); },
+    [&](Negated& s) { take(s.sentence); },
+    [&](Grouped& s) { take(s.sentence); },
+    [&](Query& s) { take(s.sentence); },
+    [](auto&) {},
+  }, value);
+}
+
+namespace logic {
+
+auto operator==(const Sentence& s1, const Sentence& s2) -> bool {
+  auto pending = std::vector<std::pair<const Sentence*, const Sentence*>>{{&s1, &s2}};
+  while (not pending.empty()) {
+    const auto [left, right] = pending.back();
+    pending.pop_back();
+    if (left->value.index() != right->value.index()) return false;
+
+    const auto equal = left->accept([&](const auto& s) {
+      using T = std::decay_t<decltype(s)>;
+      const auto& other = right->unsafeAsRef<T>();
+      if constexpr (std::is_same_v<T, Sentence::Variable> or std::is_same_v<T, Sentence::Value>) {
+        return s == other;
+      } else if constexpr (std::is_same_v<T, Sentence::Compound>) {
+        pending.emplace_back(s.left.get(), other.left.get());
+        pending.emplace_back(s.right.get(), other.right.get());
+        return s.connective == other.connective;
+      } else if constexpr (std::is_same_v<T, Sentence::Query>) {
+        pending.emplace_back(s.sentence.get(), other.sentence.get());
+        return s.keyword == other.keyword;
+      } else {
+        pending.emplace_back(s.sentence.get(), other.sentence.get());
+        return true;
       }
-      return fmt::format("{} {} {}", left, tokenTypeToString(s.connective.type), right);
-    },
-  });
+    });
+    if (not equal) return false;
+  }
+  return true;
+}
+
+}
+
+auto Sentence::asString(const Sentence& s) -> std::string {
+  // NOTE: the text of a sentence is written left to right into one string, every pending item is
+  //       either a sentence that is still to be written or some text that goes between its parts.
+  struct Item {
+    const Sentence* sentence;
+    std::string_view text;
+  };
+
+  auto string = std::string();
+  auto pending = std::vector<Item>{{&s, {}}};
+  while (not pending.empty()) {
+    const auto item = pending.back();
+    pending.pop_back();
+    if (item.sentence == nullptr) {
+      string += item.text;
+      continue;
+    }
+
+    item.sentence->accept(overloaded {
+      [&](const Sentence::Grouped& s) {
+        pending.emplace_back(nullptr, ")");
+        pending.emplace_back(s.sentence.get());
+        pending.emplace_back(nullptr, "(");
+      },
+      [&](const Sentence::Value& s) {
+        string += tokenTypeToString(s.value.type);
+      },
+      [&](const Sentence::Negated& s) {
+        string += "¬";
+        pending.emplace_back(s.sentence.get());
+      },
+      [&](const Sentence::Variable& s) {
+        string += s.identifier.lexeme;
+      },
+      [&](const Sentence::Compound& s) {
+        const auto push = [&](const Sentence& operand) {
+          if (operand.is<Sentence::Compound>()) pending.emplace_back(nullptr, ")");
+          pending.emplace_back(&operand);
+          if (operand.is<Sentence::Compound>()) pending.emplace_back(nullptr, "(");
+        };
+        push(*s.right);
+        pending.emplace_back(nullptr, " ");
+        pending.emplace_back(nullptr, tokenTypeToString(s.connective.type));
+        pending.emplace_back(nullptr, " ");
+        push(*s.left);
+      },
+      [&](const Sentence::Query& s) {
+        string += tokenTypeToString(s.keyword.type);
+        string += ' ';
+        pending.emplace_back(s.sentence.get());
+      },
+    });
+  }
+  return string;
+}
 
+auto Sentence::span(const ValueType& value) -> SourceLocation {
+  // NOTE: the line and filename are those of the keyword of a query, and otherwise of the rightmost operand.
+  return std::visit(overloaded {
+    [](const Sentence::Variable& s) { return s.identifier.location; },
+    [](const Sentence::Value& s) { return s.value.location; },
+    [](const Sentence::Grouped& s) { return s.sentence->location(); },
+    [](const Sentence::Negated& s) { return s.sentence->location(); },
+    [](const Sentence::Compound& s) { return s.right->location() + s.left->location() + s.connective.location; },
+    [](const Sentence::Query& s) { return s.keyword.location + s.sentence->location(); },
+  }, value);
 }
 
-auto Sentence::location() const -> SourceLocation {
-  return accept(overloaded {
-    [](const Sentence::Grouped& s) {
-      return s.sentence->location();
-    },
-    [](const Sentence::Value& s) {
-      return s.value.location;
-    },
-    [](const Sentence::Negated& s) {
-      return s.sentence->location();
-    },
-    [](const Sentence::Variable& s) {
-      return s.identifier.location;
-    },
-    [](const Sentence::Compound& s) {
-      return s.right->location() + s.connective.location + s.left->location();
-    },
-  });
+auto Sentence::hasAssignment(const Sentence& sentence) -> bool {
+  bool found = false;
+  walk(sentence, [&](const Sentence& current) {
+    if (found) return false;
+    found = current.is<Compound>() and current.unsafeAsRef<Compound>().connective.type == TokenType::Equal;
+    return not found;
+  }, [](const Sentence&) {});
+  return found;
 }
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <variant>
+#include <vector>
 
 namespace logic {
 
@@ -29,7 +30,7 @@ struct Sentence {
     explicit Negated(Sentence value)
         : sentence(std::make_unique<Sentence>(std::move(value))) {}
 
-    friend constexpr auto operator==(const Negated& n1, const Negated& n2) -> bool {
+    friend auto operator==(const Negated& n1, const Negated& n2) -> bool {
       return *n1.sentence == *n2.sentence;
     }
   };
@@ -39,7 +40,7 @@ struct Sentence {
     explicit Grouped(Sentence value)
         : sentence(std::make_unique<Sentence>(std::move(value))) {}
 
-    friend constexpr auto operator==(const Grouped& n1, const Grouped& n2) -> bool {
+    friend auto operator==(const Grouped& n1, const Grouped& n2) -> bool {
       return *n1.sentence == *n2.sentence;
     }
 
@@ -54,19 +55,37 @@ struct Sentence {
         , left(std::make_unique<Sentence>(std::move(left)))
         , right(std::make_unique<Sentence>(std::move(right))) {}
 
-    friend constexpr auto operator==(const Compound& s1, const Compound& s2) -> bool {
+    friend auto operator==(const Compound& s1, const Compound& s2) -> bool {
       return s1.connective == s2.connective and *s1.left == *s2.left and *s1.right == *s2.right;
     };
   };
 
-  using ValueType = std::variant<Variable, Compound, Negated, Value, Grouped>;
+  // A question about a whole sentence (e.g. `SAT P AND Q`), answered without printing its truth table.
+  struct Query {
+    Token keyword;
+    std::unique_ptr<Sentence> sentence;
+    explicit Query(Token keyword, Sentence value)
+        : keyword(keyword)
+        , sentence(std::make_unique<Sentence>(std::move(value))) {}
+
+    friend auto operator==(const Query& q1, const Query& q2) -> bool {
+      return q1.keyword == q2.keyword and *q1.sentence == *q2.sentence;
+    }
+  };
+
+  using ValueType = std::variant<Variable, Compound, Negated, Value, Grouped, Query>;
 
 public:
-  Sentence(Compound value) : value(std::move(value)) { }
-  Sentence(Grouped value) : value(std::move(value)) { }
-  Sentence(Negated value) : value(std::move(value)) { }
-  Sentence(Value value) : value(std::move(value)) { }
-  Sentence(Variable value) : value(std::move(value)) { }
+  Sentence(Compound value) : value(std::move(value)), mLocation(span(this->value)) { }
+  Sentence(Grouped value) : value(std::move(value)), mLocation(span(this->value)) { }
+  Sentence(Negated value) : value(std::move(value)), mLocation(span(this->value)) { }
+  Sentence(Value value) : value(std::move(value)), mLocation(span(this->value)) { }
+  Sentence(Variable value) : value(std::move(value)), mLocation(span(this->value)) { }
+  Sentence(Query value) : value(std::move(value)), mLocation(span(this->value)) { }
+
+  Sentence(Sentence&&) = default;
+  auto operator=(Sentence&&) -> Sentence& = default;
+  ~Sentence();
 
   constexpr auto accept(auto visitor) const -> decltype(auto) {
     return std::visit(visitor, value);
@@ -81,15 +100,80 @@ public:
     return std::get<T>(value);
   }
 
-  friend constexpr auto operator==(const Sentence&, const Sentence&) -> bool = default;
+  // NOTE: the alternatives that own children can not be copied, these are only accessible by reference.
+  template <typename T>
+  constexpr auto unsafeAsRef() const -> const T& {
+    return std::get<T>(value);
+  }
+
+  // NOTE: lets rewriting passes move the children out of a sentence they own.
+  template <typename T>
+  constexpr auto unsafeAsRef() -> T& {
+    return std::get<T>(value);
+  }
+
+  friend auto operator==(const Sentence&, const Sentence&) -> bool;
   static auto asString(const Sentence& s) -> std::string;
 
-  auto location() const -> SourceLocation;
+  // The span of every token of the sentence, it is worked out once from those of its children.
+  constexpr auto location() const -> SourceLocation {
+    return mLocation;
+  }
+
+  // Whether the sentence assigns a variable anywhere, which changes the environment of the sentences after it.
+  static auto hasAssignment(const Sentence&) -> bool;
+
+  // Walks a sentence depth first with an explicit stack, so that sentences nested arbitrarily deep do
+  // not overflow the call stack. `enter` is called on the way down and returns whether to walk the
+  // children of a sentence, `leave` is called on the way up once they have all been left, from left
+  // to right.
+  static auto walk(const Sentence&, auto&& enter, auto&& leave) -> void;
+  static auto walk(const Sentence& sentence, auto&& leave) -> void {
+    walk(sentence, [](const Sentence&) { return true; }, leave);
+  }
 
 private:
   ValueType value;
+  SourceLocation mLocation;
 
+  static auto span(const ValueType&) -> SourceLocation;
+
+  // Moves the children of the sentence out of it, see `~Sentence`.
+  auto detach(std::vector<std::unique_ptr<Sentence>>&) -> void;
 };
 
+auto Sentence::walk(const Sentence& sentence, auto&& enter, auto&& leave) -> void {
+  struct Frame {
+    const Sentence* sentence;
+    bool entered;
+  };
+
+  auto pending = std::vector<Frame>{{&sentence, false}};
+  while (not pending.empty()) {
+    auto& frame = pending.back();
+    const Sentence& current = *frame.sentence;
+    if (frame.entered) {
+      pending.pop_back();
+      leave(current);
+      continue;
+    }
+
+    frame.entered = true;
+    if (not enter(current)) continue;
+
+    // NOTE: the last child pushed is the first one walked.
+    if (current.is<Compound>()) {
+      pending.emplace_back(current.unsafeAsRef<Compound>().right.get(), false);
+      pending.emplace_back(current.unsafeAsRef<Compound>().left.get(), false);
+    } else if (current.is<Negated>()) {
+      pending.emplace_back(current.unsafeAsRef<Negated>().sentence.get(), false);
+    } else if (current.is<Grouped>()) {
+      pending.emplace_back(current.unsafeAsRef<Grouped>().sentence.get(), false);
+    } else if (current.is<Query>()) {
+      pending.emplace_back(current.unsafeAsRef<Query>().sentence.get(), false);
+    }
+  }
+}
+
 
 }
@@ -0,0 +1,343 @@
+#include "logic/parsing/simplifier.h"
+#include "logic/utils/overloaded.h"
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace logic;
+
+namespace {
+
+// NOTE: the passes below keep the results of the operands of a sentence on a stack while it is walked,
+//       see `Sentence::walk`, so none of them recurse for every level of nesting.
+template <typename T>
+auto pop(std::vector<T>& stack) -> T {
+  auto value = std::move(stack.back());
+  stack.pop_back();
+  return value;
+}
+
+auto copy(const Sentence& sentence) -> Sentence {
+  auto copies = std::vector<Sentence>();
+  Sentence::walk(sentence, [&](const Sentence& sentence) {
+    copies.push_back(sentence.accept(overloaded {
+      [](const Sentence::Variable& s) -> Sentence { return Sentence::Variable(s.identifier); },
+      [](const Sentence::Value& s) -> Sentence { return Sentence::Value(s.value); },
+      [&](const Sentence::Grouped&) -> Sentence { return Sentence::Grouped(pop(copies)); },
+      [&](const Sentence::Negated&) -> Sentence { return Sentence::Negated(pop(copies)); },
+      [&](const Sentence::Compound& s) -> Sentence {
+        auto right = pop(copies);
+        return Sentence::Compound(s.connective, pop(copies), std::move(right));
+      },
+      [&](const Sentence::Query& s) -> Sentence { return Sentence::Query(s.keyword, pop(copies)); },
+    }));
+  });
+  return pop(copies);
+}
+
+// NOTE: only the first nodes of a sentence are hashed, operands with the same hash are still compared in
+//       full. Hashing whole operands would walk every level of a nested chain again at each level.
+constexpr size_t HASHED_NODES = 32;
+
+auto hashOf(const Sentence& sentence) -> size_t {
+  static constexpr auto mix = [](size_t hash, size_t value) { return (hash ^ value) * 0x100000001B3; };
+  auto hash = size_t(0xCBF29CE484222325);
+  auto budget = HASHED_NODES;
+  const auto enter = [&](const Sentence& sentence) {
+    if (sentence.is<Sentence::Grouped>()) return true;
+    if (budget == 0) return false;
+    budget--;
+    hash = mix(hash, sentence.accept(overloaded {
+      [](const Sentence::Variable& s) { return std::hash<std::string_view>()(s.identifier.lexeme); },
+      [](const Sentence::Value& s) { return size_t(s.value.type); },
+      [](const Sentence::Grouped&) { return size_t(0); },
+      [](const Sentence::Negated&) { return size_t(0x9E3779B97F4A7C15); },
+      [](const Sentence::Compound& s) { return size_t(s.connective.type); },
+      [](const Sentence::Query& s) { return size_t(s.keyword.type); },
+    }));
+    return true;
+  };
+  Sentence::walk(sentence, enter, [](const Sentence&) {});
+  return hash;
+}
+
+auto unwrap(const Sentence& sentence) -> const Sentence& {
+  const auto* current = &sentence;
+  while (current->is<Sentence::Grouped>()) {
+    current = current->unsafeAsRef<Sentence::Grouped>().sentence.get();
+  }
+  return *current;
+}
+
+auto isConstant(const Sentence& sentence, bool value) -> bool {
+  if (not sentence.is<Sentence::Value>()) return false;
+  return (sentence.unsafeAsRef<Sentence::Value>().value.type == TokenType::True) == value;
+}
+
+auto isConnective(const Sentence& sentence, TokenType connective) -> bool {
+  return sentence.is<Sentence::Compound>() and sentence.unsafeAsRef<Sentence::Compound>().connective.type == connective;
+}
+
+auto constant(bool value, SourceLocation location) -> Sentence {
+  return Sentence::Value(Token(value ? TokenType::True : TokenType::False, location, value ? "TRUE" : "FALSE"));
+}
+
+// Whether one of the sentences is the negation of the other.
+auto isComplement(const Sentence& left, const Sentence& right) -> bool {
+  const auto negates = [](const Sentence& negated, const Sentence& operand) {
+    return negated.is<Sentence::Negated>() and unwrap(*negated.unsafeAsRef<Sentence::Negated>().sentence) == unwrap(operand);
+  };
+  return negates(left, right) or negates(right, left);
+}
+
+auto negation(Sentence operand) -> Sentence {
+  if (operand.is<Sentence::Value>()) {
+    const auto& token = operand.unsafeAsRef<Sentence::Value>().value;
+    return constant(token.type == TokenType::False, token.location);
+  }
+  if (operand.is<Sentence::Negated>()) {
+    auto inner = std::move(*operand.unsafeAsRef<Sentence::Negated>().sentence);
+    if (inner.is<Sentence::Grouped>()) return std::move(*inner.unsafeAsRef<Sentence::Grouped>().sentence);
+    return inner;
+  }
+  // NOTE: `¬` binds tighter than every connective, so it is the only place that keeps its parentheses.
+  if (operand.is<Sentence::Compound>()) {
+    return Sentence::Negated(Sentence::Grouped(std::move(operand)));
+  }
+  return Sentence::Negated(std::move(operand));
+}
+
+// Lists the operands of a chain of one associative connective, looking through parentheses.
+auto collect(const Sentence& sentence, TokenType connective, std::vector<const Sentence*>& operands) -> void {
+  const auto enter = [&](const Sentence& current) {
+    if (current.is<Sentence::Grouped>() or isConnective(current, connective)) return true;
+    operands.push_back(&current);
+    return false;
+  };
+  Sentence::walk(sentence, enter, [](const Sentence&) {});
+}
+
+// Like `collect`, but moves the operands out of a sentence that was already rewritten.
+auto splice(Sentence sentence, TokenType connective, std::vector<Sentence>& operands) -> void {
+  auto pending = std::vector<Sentence>();
+  pending.push_back(std::move(sentence));
+  while (not pending.empty()) {
+    auto current = pop(pending);
+    if (current.is<Sentence::Grouped>()) {
+      pending.push_back(std::move(*current.unsafeAsRef<Sentence::Grouped>().sentence));
+    } else if (isConnective(current, connective)) {
+      auto& compound = current.unsafeAsRef<Sentence::Compound>();
+      pending.push_back(std::move(*compound.right));
+      pending.push_back(std::move(*compound.left));
+    } else {
+      operands.push_back(std::move(current));
+    }
+  }
+}
+
+// The distinct operands of a chain, in the order they first appear.
+class Operands {
+
+private:
+  std::vector<Sentence> mOperands;
+  std::unordered_multimap<size_t, size_t> mIndex;
+
+public:
+  auto contains(const Sentence& sentence) const -> bool {
+    const auto [begin, end] = mIndex.equal_range(hashOf(sentence));
+    for (auto it = begin; it != end; it++) {
+      if (unwrap(mOperands[it->second]) == unwrap(sentence)) return true;
+    }
+    return false;
+  }
+
+  auto add(Sentence sentence) -> void {
+    if (contains(sentence)) return;
+    mIndex.emplace(hashOf(sentence), mOperands.size());
+    mOperands.push_back(std::move(sentence));
+  }
+
+  auto operands() -> std::vector<Sentence>& {
+    return mOperands;
+  }
+};
+
+// Simplifies a chain of `AND` or `OR` as a whole: `TRUE` and `FALSE` are the identity and the
+// annihilator of `AND` and the other way around for `OR`. Repeated operands are dropped, an operand
+// next to its complement decides the chain, and an operand absorbs the operands of the dual connective
+// it is part of, `A AND (A OR B)` is `A`.
+auto simplifyChain(Token connective, std::vector<Sentence> rewritten, SourceLocation location) -> Sentence {
+  const auto annihilator = connective.type == TokenType::Or;
+  const auto dual = connective.type == TokenType::And ? TokenType::Or : TokenType::And;
+
+  auto set = Operands();
+  for (auto& operand : rewritten) {
+    if (isConstant(operand, annihilator)) return constant(annihilator, location);
+    if (isConstant(operand, not annihilator)) continue;
+    set.add(std::move(operand));
+  }
+
+  auto& operands = set.operands();
+  for (const auto& operand : operands) {
+    if (operand.is<Sentence::Negated>() and set.contains(*operand.unsafeAsRef<Sentence::Negated>().sentence)) {
+      return constant(annihilator, location);
+    }
+  }
+
+  auto absorbed = std::vector<bool>(operands.size(), false);
+  auto inner = std::vector<const Sentence*>();
+  for (size_t i = 0; i < operands.size(); i++) {
+    if (not isConnective(operands[i], dual)) continue;
+    inner.clear();
+    collect(operands[i], dual, inner);
+    absorbed[i] = std::ranges::any_of(inner, [&](const Sentence* sentence) { return set.contains(*sentence); });
+  }
+
+  auto kept = std::vector<Sentence>();
+  for (size_t i = 0; i < operands.size(); i++) {
+    if (not absorbed[i]) kept.push_back(std::move(operands[i]));
+  }
+
+  if (kept.empty()) return constant(not annihilator, location);
+
+  // NOTE: the chain is rebuilt right associative, which is how the parser reads it.
+  auto result = std::move(kept.back());
+  for (auto i = kept.size() - 1; i-- > 0;) {
+    result = Sentence::Compound(connective, std::move(kept[i]), std::move(result));
+  }
+  return result;
+}
+
+auto simplifyBinary(Token connective, Sentence left, Sentence right, SourceLocation location) -> Sentence {
+  if (connective.type == TokenType::Implies) {
+    if (isConstant(left, false) or isConstant(right, true)) return constant(true, location);
+    if (isConstant(left, true)) return right;
+    if (isConstant(right, false)) return negation(std::move(left));
+    if (unwrap(left) == unwrap(right)) return constant(true, location);
+    // NOTE: `A => ¬A` is `¬A` and `¬A => A` is `A`.
+    if (isComplement(left, right)) return right;
+  }
+
+  if (connective.type == TokenType::Equivalent) {
+    if (isConstant(left, true)) return right;
+    if (isConstant(right, true)) return left;
+    if (isConstant(left, false)) return negation(std::move(right));
+    if (isConstant(right, false)) return negation(std::move(left));
+    if (unwrap(left) == unwrap(right)) return constant(true, location);
+    if (isComplement(left, right)) return constant(false, location);
+  }
+
+  return Sentence::Compound(connective, std::move(left), std::move(right));
+}
+
+auto rewrite(const Sentence& sentence) -> Sentence {
+  // A sentence whose operands are being rewritten, a chain of `AND` or `OR` has all of its operands at once.
+  struct Frame {
+    const Sentence* sentence;
+    std::vector<const Sentence*> operands;
+    size_t next;
+    // where the rewritten operands of the sentence start.
+    size_t rewritten;
+  };
+
+  auto rewritten = std::vector<Sentence>();
+  auto frames = std::vector<Frame>();
+  const auto push = [&](const Sentence& sentence) {
+    auto& frame = frames.emplace_back(&sentence, std::vector<const Sentence*>(), 0, rewritten.size());
+    sentence.accept(overloaded {
+      [&](const Sentence::Compound& s) {
+        if (s.connective.type == TokenType::And or s.connective.type == TokenType::Or) {
+          collect(sentence, s.connective.type, frame.operands);
+        } else if (s.connective.type != TokenType::Equal) {
+          frame.operands = {s.left.get(), s.right.get()};
+        }
+      },
+      [&](const Sentence::Negated& s) { frame.operands = {s.sentence.get()}; },
+      [&](const Sentence::Grouped& s) { frame.operands = {s.sentence.get()}; },
+      [&](const Sentence::Query& s) { frame.operands = {s.sentence.get()}; },
+      [](const auto&) {},
+    });
+  };
+
+  push(sentence);
+  while (not frames.empty()) {
+    auto& frame = frames.back();
+    if (frame.next < frame.operands.size()) {
+      push(*frame.operands[frame.next++]);
+      continue;
+    }
+
+    const auto& current = *frame.sentence;
+    auto result = current.accept(overloaded {
+      [](const Sentence::Variable& s) -> Sentence { return Sentence::Variable(s.identifier); },
+      [](const Sentence::Value& s) -> Sentence { return Sentence::Value(s.value); },
+      [&](const Sentence::Grouped&) -> Sentence { return pop(rewritten); },
+      [&](const Sentence::Negated&) -> Sentence { return negation(pop(rewritten)); },
+      [&](const Sentence::Query& s) -> Sentence { return Sentence::Query(s.keyword, pop(rewritten)); },
+      [&](const Sentence::Compound& s) -> Sentence {
+        const auto type = s.connective.type;
+        if (type == TokenType::Equal) return copy(current);
+
+        if (type == TokenType::And or type == TokenType::Or) {
+          auto operands = std::vector<Sentence>();
+          for (auto i = frame.rewritten; i < rewritten.size(); i++) {
+            splice(std::move(rewritten[i]), type, operands);
+          }
+          rewritten.erase(rewritten.begin() + ptrdiff_t(frame.rewritten), rewritten.end());
+          return simplifyChain(s.connective, std::move(operands), current.location());
+        }
+
+        auto right = pop(rewritten);
+        return simplifyBinary(s.connective, pop(rewritten), std::move(right), current.location());
+      },
+    });
+    frames.pop_back();
+    rewritten.push_back(std::move(result));
+  }
+  return pop(rewritten);
+}
+
+auto contains(const Sentence& sentence, TokenType connective) -> bool {
+  bool found = false;
+  Sentence::walk(sentence, [&](const Sentence&) { return not found; }, [&](const Sentence& sentence) {
+    found = found or isConnective(sentence, connective);
+  });
+  return found;
+}
+
+}
+
+auto Simplifier::simplify(const Sentence& sentence) -> Sentence {
+  if (not isSimplifiable(sentence)) return copy(sentence);
+
+  // NOTE: a rewritten operand can make its parent simplifiable again, e.g. once `¬¬A` is `A` the
+  //       chain it is part of may contain `A` twice. Every pass shrinks the sentence, so it is repeated
+  //       until one does not.
+  auto result = rewrite(sentence);
+  auto resultSize = size(result);
+  while (true) {
+    auto next = rewrite(result);
+    const auto nextSize = size(next);
+    if (nextSize >= resultSize) return next;
+    result = std::move(next);
+    resultSize = nextSize;
+  }
+}
+
+auto Simplifier::isSimplifiable(const Sentence& sentence) -> bool {
+  if (sentence.is<Sentence::Query>() and sentence.unsafeAsRef<Sentence::Query>().keyword.type == TokenType::Count) {
+    return false;
+  }
+  return not contains(sentence, TokenType::Equal);
+}
+
+auto Simplifier::size(const Sentence& sentence) -> size_t {
+  size_t size = 0;
+  Sentence::walk(sentence, [&](const Sentence& sentence) {
+    size += not sentence.is<Sentence::Grouped>() and not sentence.is<Sentence::Query>();
+  });
+  return size;
+}
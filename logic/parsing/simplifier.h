@@ -0,0 +1,27 @@
+#pragma once
+
+#include "logic/parsing/sentence.h"
+
+namespace logic {
+
+// Rewrites a sentence with the laws of boolean algebra until none of them applies anymore: constants
+// are folded, double negations eliminated, and the operands of chains of `AND` and `OR` are flattened
+// and checked for idempotence, complements and absorption. Parentheses are dropped wherever
+// `Sentence::asString` puts them back.
+//
+// The simplified sentence is equivalent to the original one on every row, but it may mention fewer
+// variables than the original one.
+class Simplifier {
+
+public:
+  static auto simplify(const Sentence&) -> Sentence;
+
+  // Sentences with assignments are not simplified since they change the environment, and neither are
+  // `COUNT` queries since the number of models depends on the variables of the sentence.
+  static auto isSimplifiable(const Sentence&) -> bool;
+
+  // The number of connectives, variables and constants of a sentence, parentheses are not counted.
+  static auto size(const Sentence&) -> size_t;
+};
+
+}
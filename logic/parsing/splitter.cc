@@ -0,0 +1,94 @@
+#include "logic/parsing/splitter.h"
+
+#include <cctype>
+
+using namespace logic;
+
+namespace {
+
+auto isBinaryConnective(std::string_view word) -> bool {
+  return word == "AND" or word == "OR" or word == "IMPLIES" or word == "EQUIVALENT" or word == "=";
+}
+
+// Words after which a sentence cannot end.
+auto expectsOperand(std::string_view word) -> bool {
+  return word.empty() or word == "(" or word == "NOT" or word == "SAT" or word == "VALID" or word == "COUNT"
+    or isBinaryConnective(word);
+}
+
+auto wordAt(std::string_view source, size_t i) -> std::string_view {
+  if (not std::isalnum(static_cast<unsigned char>(source[i]))) {
+    return source.substr(i, 1);
+  }
+  auto end = i;
+  while (end < source.size() and std::isalnum(static_cast<unsigned char>(source[end]))) end++;
+  return source.substr(i, end - i);
+}
+
+// The first word at or after `i`, skipping whitespace and comments.
+auto nextWord(std::string_view source, size_t i) -> std::string_view {
+  while (i < source.size()) {
+    const auto c = source[i];
+    if (c == '#') {
+      while (i < source.size() and source[i] != '\n') i++;
+    } else if (std::isspace(static_cast<unsigned char>(c))) {
+      i++;
+    } else {
+      return wordAt(source, i);
+    }
+  }
+  return {};
+}
+
+}
+
+auto logic::splitShards(std::string_view source, size_t targetSize) -> std::vector<Shard> {
+  auto shards = std::vector<Shard>();
+  size_t start = 0, startLine = 1, line = 1;
+  size_t depth = 0;
+  auto last = std::string_view();
+
+  for (size_t i = 0; i < source.size(); i++) {
+    const auto c = source[i];
+    switch (c) {
+      case '#':
+        while (i + 1 < source.size() and source[i + 1] != '\n') i++;
+        break;
+      case '(':
+        depth++;
+        last = "(";
+        break;
+      case ')':
+        depth -= depth > 0;
+        last = ")";
+        break;
+      case '=':
+        last = "=";
+        break;
+      case '\n': {
+        line++;
+        const auto end = i + 1;
+        if (end - start < targetSize or depth != 0 or expectsOperand(last)) break;
+        const auto next = nextWord(source, end);
+        if (isBinaryConnective(next) or next == ")") break;
+
+        shards.emplace_back(source.substr(start, end - start), startLine);
+        start = end;
+        startLine = line;
+        last = {};
+        break;
+      }
+      default:
+        if (std::isalnum(static_cast<unsigned char>(c))) {
+          last = wordAt(source, i);
+          i += last.size() - 1;
+        }
+        break;
+    }
+  }
+
+  if (start < source.size() or shards.empty()) {
+    shards.emplace_back(source.substr(start), startLine);
+  }
+  return shards;
+}
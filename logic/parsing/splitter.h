@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace logic {
+
+// A slice of a source that holds whole sentences, so it can be scanned and parsed on its own.
+struct Shard {
+  std::string_view source;
+  // the line of the whole source the shard starts at.
+  size_t line;
+};
+
+// Splits a source into shards of at least `targetSize` bytes without scanning it. Shards end at line
+// breaks outside of parentheses where the previous word does not expect an operand and the next one
+// is not a binary connective, which are exactly the places a sentence can end, so parsing the shards
+// one after another gives the same sentences as parsing the whole source.
+auto splitShards(std::string_view source, size_t targetSize) -> std::vector<Shard>;
+
+}
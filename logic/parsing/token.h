@@ -19,6 +19,9 @@ enum class TokenType {
   Implies,
   Equivalent,
   Equal,
+  Sat,
+  Valid,
+  Count,
   EndOfFile,
 };
 
@@ -60,6 +63,12 @@ constexpr auto tokenTypeToString(TokenType type) -> std::string_view {
       return "<=>";
     case TokenType::Equal:
       return "=";
+    case TokenType::Sat:
+      return "SAT";
+    case TokenType::Valid:
+      return "VALID";
+    case TokenType::Count:
+      return "COUNT";
     case TokenType::EndOfFile:
       return "EOF";
   }
@@ -0,0 +1,143 @@
+#include "logic/solver/cnf.h"
+
+#include <limits>
+#include <optional>
+#include <utility>
+
+using namespace logic;
+
+auto Cnf::addClause(std::span<const Literal> clause) -> void {
+  mLiterals.insert(mLiterals.end(), clause.begin(), clause.end());
+  mOffsets.push_back(mLiterals.size());
+}
+
+auto Tseitin::encode(const NodeTable& nodes, NodeId root, Polarity polarity, ClauseSink& cnf) -> Encoding {
+  static constexpr auto UNUSED = std::numeric_limits<uint32_t>::max();
+  auto encoding = Encoding(Literal(0), std::vector<uint32_t>(nodes.variables().size(), UNUSED));
+
+  static constexpr uint8_t POSITIVE = 1, NEGATIVE = 2, BOTH = POSITIVE | NEGATIVE;
+  static constexpr auto flip = [](uint8_t polarities) -> uint8_t {
+    return ((polarities & POSITIVE) << 1) | ((polarities & NEGATIVE) >> 1);
+  };
+
+  // NOTE: children always have smaller ids than their parents, so walking the ids downwards from the
+  //       root finds the polarities every node is used in (none if it is unreachable), and walking them
+  //       upwards encodes children first.
+  std::vector<uint8_t> polarities(root + 1, 0);
+  polarities[root] = polarity == Polarity::Positive ? POSITIVE : polarity == Polarity::Negative ? NEGATIVE : BOTH;
+  for (auto id = root + 1; id-- > 0;) {
+    const auto current = polarities[id];
+    if (current == 0) continue;
+
+    const auto& node = nodes[id];
+    switch (node.kind) {
+      case Node::Kind::Negation:
+        polarities[node.left] |= flip(current);
+        break;
+      case Node::Kind::Conjunction:
+      case Node::Kind::Disjunction:
+        polarities[node.left] |= current;
+        polarities[node.right] |= current;
+        break;
+      case Node::Kind::Implication:
+        polarities[node.left] |= flip(current);
+        polarities[node.right] |= current;
+        break;
+      case Node::Kind::Bijection:
+        polarities[node.left] |= BOTH;
+        polarities[node.right] |= BOTH;
+        break;
+      default:
+        break;
+    }
+  }
+
+  std::optional<Literal> truth;
+  std::vector<Literal> literals(root + 1, Literal(0));
+
+  for (NodeId id = 0; id <= root; id++) {
+    if (polarities[id] == 0) continue;
+
+    const auto& node = nodes[id];
+    switch (node.kind) {
+      case Node::Kind::Variable: {
+        auto variable = cnf.newVariable();
+        encoding.inputs[node.left] = variable;
+        literals[id] = Literal::positive(variable);
+        continue;
+      }
+      case Node::Kind::Constant: {
+        if (not truth.has_value()) {
+          truth = Literal::positive(cnf.newVariable());
+          cnf.addClause({*truth});
+        }
+        literals[id] = node.left ? *truth : ~*truth;
+        continue;
+      }
+      case Node::Kind::Negation:
+        literals[id] = ~literals[node.left];
+        continue;
+      default:
+        break;
+    }
+
+    const auto x = Literal::positive(cnf.newVariable());
+    const auto a = literals[node.left];
+    const auto b = literals[node.right];
+    literals[id] = x;
+
+    // x => f, needed when the node is used positively.
+    if (polarities[id] & POSITIVE) {
+      switch (node.kind) {
+        case Node::Kind::Conjunction:
+          cnf.addClause({~x, a});
+          cnf.addClause({~x, b});
+          break;
+        case Node::Kind::Disjunction:
+          cnf.addClause({~x, a, b});
+          break;
+        case Node::Kind::Implication:
+          cnf.addClause({~x, ~a, b});
+          break;
+        case Node::Kind::Bijection:
+          cnf.addClause({~x, ~a, b});
+          cnf.addClause({~x, a, ~b});
+          break;
+        default:
+          std::unreachable();
+      }
+    }
+
+    // f => x, needed when the node is used negatively.
+    if (polarities[id] & NEGATIVE) {
+      switch (node.kind) {
+        case Node::Kind::Conjunction:
+          cnf.addClause({x, ~a, ~b});
+          break;
+        case Node::Kind::Disjunction:
+          cnf.addClause({x, ~a});
+          cnf.addClause({x, ~b});
+          break;
+        case Node::Kind::Implication:
+          cnf.addClause({x, a});
+          cnf.addClause({x, ~b});
+          break;
+        case Node::Kind::Bijection:
+          cnf.addClause({x, a, b});
+          cnf.addClause({x, ~a, ~b});
+          break;
+        default:
+          std::unreachable();
+      }
+    }
+  }
+
+  // NOTE: variables of the node table that are not reachable from the root still get a variable so
+  //       that a model assigns all of them.
+  for (auto& input : encoding.inputs) {
+    if (input == UNUSED) input = cnf.newVariable();
+  }
+
+  encoding.root = literals[root];
+  return encoding;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+#include "logic/evaluation/nodeTable.h"
+
+namespace logic {
+
+// A variable or its negation, encoded as `2 * variable + negated` so that literals can index arrays directly.
+struct Literal {
+  uint32_t code;
+
+  static constexpr auto positive(uint32_t variable) -> Literal {
+    return Literal(variable << 1);
+  }
+
+  static constexpr auto negative(uint32_t variable) -> Literal {
+    return Literal((variable << 1) | 1);
+  }
+
+  constexpr auto variable() const -> uint32_t {
+    return code >> 1;
+  }
+
+  constexpr auto isNegated() const -> bool {
+    return code & 1;
+  }
+
+  constexpr auto operator~() const -> Literal {
+    return Literal(code ^ 1);
+  }
+
+  friend constexpr auto operator==(const Literal&, const Literal&) -> bool = default;
+};
+
+// Receives the variables and clauses of an encoding as they are produced, so that a consumer such as
+// a DIMACS writer does not need the whole formula in memory.
+class ClauseSink {
+
+public:
+  virtual ~ClauseSink() = default;
+
+  virtual auto newVariable() -> uint32_t = 0;
+  virtual auto addClause(std::span<const Literal> clause) -> void = 0;
+
+  auto addClause(std::initializer_list<Literal> clause) -> void {
+    addClause(std::span(clause.begin(), clause.size()));
+  }
+};
+
+// A formula in conjunctive normal form, the clauses are stored back to back in a single buffer.
+class Cnf : public ClauseSink {
+
+private:
+  uint32_t mVariables = 0;
+  std::vector<Literal> mLiterals;
+  std::vector<size_t> mOffsets = {0};
+
+public:
+  using ClauseSink::addClause;
+
+  auto newVariable() -> uint32_t override {
+    return mVariables++;
+  }
+
+  auto addClause(std::span<const Literal> clause) -> void override;
+
+  constexpr auto variables() const -> uint32_t {
+    return mVariables;
+  }
+
+  constexpr auto clauses() const -> size_t {
+    return mOffsets.size() - 1;
+  }
+
+  constexpr auto clause(size_t i) const -> std::span<const Literal> {
+    return std::span(mLiterals).subspan(mOffsets[i], mOffsets[i + 1] - mOffsets[i]);
+  }
+};
+
+// Tseitin translation of a hash-consed sentence: every connective gets a fresh variable that is
+// constrained to be equivalent to it, so the CNF grows linearly with the number of distinct nodes.
+//
+// When the root is only ever asserted in one polarity, the Plaisted-Greenbaum variant only emits the
+// implications each sub-formula is used in, which drops about half of the clauses. The result is
+// equisatisfiable and its models still satisfy the sentence, but unlike the full translation the
+// number of models is not preserved.
+class Tseitin {
+
+public:
+  enum class Polarity {
+    Positive,
+    Negative,
+    Both,
+  };
+
+  struct Encoding {
+    Literal root;
+    // the CNF variable of every variable of the node table, by its index.
+    std::vector<uint32_t> inputs;
+  };
+
+  // The root is not asserted, the caller adds a unit clause of the root literal in the given polarity.
+  static auto encode(const NodeTable&, NodeId root, Polarity, ClauseSink&) -> Encoding;
+};
+
+}
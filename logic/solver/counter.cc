@@ -0,0 +1,207 @@
+#include "logic/solver/counter.h"
+
+#include <algorithm>
+
+using namespace logic;
+
+auto Counter::KeyHash::operator()(const std::vector<uint32_t>& key) const -> size_t {
+  size_t hash = 0xCBF29CE484222325;
+  for (auto value : key) {
+    hash = (hash ^ value) * 0x100000001B3;
+  }
+  return hash;
+}
+
+Counter::Counter(const Cnf& cnf)
+  : mCnf(cnf),
+    mOccurrences(2 * size_t(cnf.variables())),
+    mValues(cnf.variables(), Value::Unassigned),
+    mVariableStamps(cnf.variables(), 0),
+    mClauseStamps(cnf.clauses(), 0) {
+
+  for (size_t i = 0; i < cnf.clauses(); i++) {
+    for (auto literal : cnf.clause(i)) {
+      mOccurrences[literal.code].push_back(i);
+    }
+  }
+}
+
+auto Counter::count() -> BigInt {
+  mTrail.clear();
+  std::ranges::fill(mValues, Value::Unassigned);
+
+  for (size_t i = 0; i < mCnf.clauses(); i++) {
+    const auto clause = mCnf.clause(i);
+    if (clause.empty()) return BigInt();
+    if (clause.size() != 1) continue;
+
+    const auto value = valueOf(clause[0]);
+    if (value == Value::False) return BigInt();
+    if (value == Value::Unassigned) assign(clause[0]);
+  }
+  if (not propagate(0)) return BigInt();
+
+  auto variables = std::vector<uint32_t>();
+  for (uint32_t variable = 0; variable < mCnf.variables(); variable++) {
+    if (mValues[variable] == Value::Unassigned) variables.push_back(variable);
+  }
+  return countResidual(variables);
+}
+
+auto Counter::countResidual(const std::vector<uint32_t>& variables) -> BigInt {
+  struct Component {
+    std::vector<uint32_t> variables;
+    std::vector<uint32_t> clauses;
+  };
+
+  mStamp++;
+  size_t unconstrained = 0;
+  auto components = std::vector<Component>();
+  auto stack = std::vector<uint32_t>();
+
+  for (auto start : variables) {
+    if (mVariableStamps[start] == mStamp) continue;
+
+    auto component = Component();
+    mVariableStamps[start] = mStamp;
+    stack.push_back(start);
+
+    while (not stack.empty()) {
+      const auto variable = stack.back();
+      stack.pop_back();
+      component.variables.push_back(variable);
+
+      for (auto literal : {Literal::positive(variable), Literal::negative(variable)}) {
+        for (auto clause : mOccurrences[literal.code]) {
+          if (mClauseStamps[clause] == mStamp) continue;
+          mClauseStamps[clause] = mStamp;
+          if (isSatisfied(clause)) continue;
+
+          component.clauses.push_back(clause);
+          for (auto other : mCnf.clause(clause)) {
+            const auto next = other.variable();
+            if (mValues[next] != Value::Unassigned or mVariableStamps[next] == mStamp) continue;
+            mVariableStamps[next] = mStamp;
+            stack.push_back(next);
+          }
+        }
+      }
+    }
+
+    // NOTE: a variable that no unsatisfied clause mentions doubles the count whatever its value.
+    if (component.clauses.empty()) {
+      unconstrained += component.variables.size();
+    } else {
+      components.push_back(std::move(component));
+    }
+  }
+
+  // NOTE: the components are all found before counting any of them, the recursion reuses the stamps.
+  auto result = BigInt::powerOfTwo(unconstrained);
+  for (auto& component : components) {
+    const auto count = countComponent(component.variables, component.clauses);
+    if (count.isZero()) return BigInt();
+    result *= count;
+  }
+  return result;
+}
+
+auto Counter::countComponent(const std::vector<uint32_t>& variables, const std::vector<uint32_t>& clauses) -> BigInt {
+  mStatistics.components++;
+
+  auto key = std::vector<uint32_t>();
+  key.reserve(variables.size() + clauses.size() + 1);
+  key.insert(key.end(), variables.begin(), variables.end());
+  std::sort(key.begin(), key.end());
+  key.push_back(UINT32_MAX);
+  const auto separator = key.size();
+  key.insert(key.end(), clauses.begin(), clauses.end());
+  std::sort(key.begin() + separator, key.end());
+
+  if (auto cached = mCache.find(key); cached != mCache.end()) {
+    mStatistics.cacheHits++;
+    return cached->second;
+  }
+
+  // NOTE: branching on the variable with the most occurrences in the component splits it the most.
+  auto best = variables.front();
+  size_t bestScore = 0;
+  for (auto variable : variables) {
+    size_t score = 0;
+    for (auto literal : {Literal::positive(variable), Literal::negative(variable)}) {
+      for (auto clause : mOccurrences[literal.code]) {
+        score += not isSatisfied(clause);
+      }
+    }
+    if (score > bestScore) {
+      best = variable;
+      bestScore = score;
+    }
+  }
+
+  auto total = BigInt();
+  auto remaining = std::vector<uint32_t>();
+  for (auto literal : {Literal::positive(best), Literal::negative(best)}) {
+    mStatistics.decisions++;
+    const auto mark = mTrail.size();
+    assign(literal);
+
+    if (propagate(mark)) {
+      remaining.clear();
+      for (auto variable : variables) {
+        if (mValues[variable] == Value::Unassigned) remaining.push_back(variable);
+      }
+      total += countResidual(remaining);
+    }
+    backtrack(mark);
+  }
+
+  if (mCache.size() >= MAX_CACHE_ENTRIES) mCache.clear();
+  mCache.emplace(std::move(key), total);
+  return total;
+}
+
+auto Counter::assign(Literal literal) -> void {
+  mValues[literal.variable()] = literal.isNegated() ? Value::False : Value::True;
+  mTrail.push_back(literal.variable());
+}
+
+auto Counter::propagate(size_t from) -> bool {
+  for (auto i = from; i < mTrail.size(); i++) {
+    const auto variable = mTrail[i];
+    const auto falsified = mValues[variable] == Value::True ? Literal::negative(variable) : Literal::positive(variable);
+
+    for (auto clause : mOccurrences[falsified.code]) {
+      size_t unassigned = 0;
+      auto unit = Literal(0);
+      bool satisfied = false;
+      for (auto literal : mCnf.clause(clause)) {
+        const auto value = valueOf(literal);
+        if (value == Value::True) {
+          satisfied = true;
+          break;
+        }
+        if (value == Value::Unassigned) {
+          unassigned++;
+          unit = literal;
+        }
+      }
+
+      if (satisfied or unassigned > 1) continue;
+      if (unassigned == 0) return false;
+      assign(unit);
+    }
+  }
+  return true;
+}
+
+auto Counter::backtrack(size_t to) -> void {
+  while (mTrail.size() > to) {
+    mValues[mTrail.back()] = Value::Unassigned;
+    mTrail.pop_back();
+  }
+}
+
+auto Counter::isSatisfied(uint32_t clause) const -> bool {
+  return std::ranges::any_of(mCnf.clause(clause), [&](Literal literal) { return valueOf(literal) == Value::True; });
+}
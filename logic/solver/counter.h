@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "logic/solver/cnf.h"
+#include "logic/utils/bigInt.h"
+
+namespace logic {
+
+// An exact model counter in the style of sharpSAT: DPLL search with unit propagation that splits the
+// residual formula into connected components, counts each of them independently and multiplies the
+// results. Counts of components are cached, keyed by their variables and unsatisfied clauses, which
+// identify the residual formula exactly.
+//
+// Every variable of the CNF is counted, so the count of a full Tseitin encoding is the number of
+// models of the sentence over its inputs.
+class Counter {
+
+public:
+  struct Statistics {
+    size_t decisions = 0;
+    size_t components = 0;
+    size_t cacheHits = 0;
+  };
+
+private:
+  enum class Value : uint8_t {
+    Unassigned,
+    True,
+    False,
+  };
+
+  struct KeyHash {
+    auto operator()(const std::vector<uint32_t>& key) const -> size_t;
+  };
+
+  // NOTE: the cache is cleared when it reaches this many entries, which only costs recomputation.
+  static constexpr size_t MAX_CACHE_ENTRIES = 1 << 20;
+
+  const Cnf& mCnf;
+  std::vector<std::vector<uint32_t>> mOccurrences;
+  std::vector<Value> mValues;
+  std::vector<uint32_t> mTrail;
+
+  // scratch space of the component search, stamped to avoid clearing it between searches.
+  std::vector<uint32_t> mVariableStamps;
+  std::vector<uint32_t> mClauseStamps;
+  uint32_t mStamp = 0;
+
+  std::unordered_map<std::vector<uint32_t>, BigInt, KeyHash> mCache;
+  Statistics mStatistics;
+
+public:
+  explicit Counter(const Cnf&);
+
+  auto count() -> BigInt;
+
+  constexpr auto statistics() const -> const Statistics& {
+    return mStatistics;
+  }
+
+private:
+  // Counts the models of the residual formula over the given unassigned variables.
+  auto countResidual(const std::vector<uint32_t>& variables) -> BigInt;
+  auto countComponent(const std::vector<uint32_t>& variables, const std::vector<uint32_t>& clauses) -> BigInt;
+
+  auto assign(Literal) -> void;
+  auto propagate(size_t from) -> bool;
+  auto backtrack(size_t to) -> void;
+
+  constexpr auto valueOf(Literal literal) const -> Value {
+    const auto value = mValues[literal.variable()];
+    if (value == Value::Unassigned or not literal.isNegated()) return value;
+    return value == Value::True ? Value::False : Value::True;
+  }
+
+  auto isSatisfied(uint32_t clause) const -> bool;
+};
+
+}
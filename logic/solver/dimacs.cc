@@ -0,0 +1,33 @@
+#include "logic/solver/dimacs.h"
+
+#include <iterator>
+
+using namespace logic;
+
+DimacsWriter::~DimacsWriter() {
+  flush();
+}
+
+auto DimacsWriter::addClause(std::span<const Literal> clause) -> void {
+  // NOTE: DIMACS variables start at 1 and a negative number is a negated literal.
+  for (auto literal : clause) {
+    const auto variable = int64_t(literal.variable()) + 1;
+    fmt::format_to(std::back_inserter(mBuffer), "{} ", literal.isNegated() ? -variable : variable);
+  }
+  mBuffer.append(std::string_view("0\n"));
+
+  if (mBuffer.size() >= FLUSH_THRESHOLD) flush();
+}
+
+auto DimacsWriter::comment(std::string_view text) -> void {
+  fmt::format_to(std::back_inserter(mBuffer), "c {}\n", text);
+}
+
+auto DimacsWriter::header(uint32_t variables, size_t clauses) -> void {
+  fmt::format_to(std::back_inserter(mBuffer), "p cnf {} {}\n", variables, clauses);
+}
+
+auto DimacsWriter::flush() -> void {
+  std::fwrite(mBuffer.data(), 1, mBuffer.size(), mFile);
+  mBuffer.clear();
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "logic/solver/cnf.h"
+
+namespace logic {
+
+// Counts what an encoding produces without storing it, the first pass of a streaming DIMACS export
+// since the header comes before the clauses.
+class ClauseCounter : public ClauseSink {
+
+private:
+  uint32_t mVariables = 0;
+  size_t mClauses = 0;
+
+public:
+  using ClauseSink::addClause;
+
+  auto newVariable() -> uint32_t override {
+    return mVariables++;
+  }
+
+  auto addClause(std::span<const Literal>) -> void override {
+    mClauses++;
+  }
+
+  constexpr auto variables() const -> uint32_t {
+    return mVariables;
+  }
+
+  constexpr auto clauses() const -> size_t {
+    return mClauses;
+  }
+};
+
+// Writes clauses in the DIMACS CNF format as they are produced, through a buffer that is flushed to
+// the file whenever it grows past `FLUSH_THRESHOLD`, so memory stays constant whatever the formula size.
+class DimacsWriter : public ClauseSink {
+
+private:
+  static constexpr size_t FLUSH_THRESHOLD = 1 << 16;
+
+  std::FILE* mFile;
+  fmt::memory_buffer mBuffer;
+  uint32_t mVariables = 0;
+
+public:
+  explicit DimacsWriter(std::FILE* file) : mFile(file) {}
+  ~DimacsWriter() override;
+
+  DimacsWriter(const DimacsWriter&) = delete;
+  auto operator=(const DimacsWriter&) -> DimacsWriter& = delete;
+
+  using ClauseSink::addClause;
+
+  auto newVariable() -> uint32_t override {
+    return mVariables++;
+  }
+
+  auto addClause(std::span<const Literal> clause) -> void override;
+
+  auto comment(std::string_view) -> void;
+  auto header(uint32_t variables, size_t clauses) -> void;
+  auto flush() -> void;
+};
+
+}
@@ -0,0 +1,210 @@
+#include "logic/solver/prover.h"
+#include "logic/solver/cnf.h"
+#include "logic/solver/counter.h"
+#include "logic/solver/dimacs.h"
+#include "logic/bdd/bdd.h"
+
+#include "logic/utils/color.h"
+#include "logic/utils/output.h"
+#include "logic/utils/macros.h"
+#include "logic/utils/overloaded.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+using namespace logic;
+
+auto Prover::prove(const Sentence::Query& query) -> std::expected<Answer, EvaluatorError> {
+  auto nodes = NodeTable();
+  const auto root = TRY(lower(*query.sentence, nodes));
+
+  const auto type = query.keyword.type;
+  auto answer = mBackend == Backend::Bdd ? proveWithBdd(type, nodes, root)
+    : type == TokenType::Count ? countWithCounter(nodes, root)
+    : proveWithSolver(type, nodes, root);
+  std::ranges::sort(answer.witness);
+  return answer;
+}
+
+auto Prover::proveWithSolver(TokenType query, const NodeTable& nodes, NodeId root) -> Answer {
+  auto cnf = Cnf();
+  const auto encoding = encode(query, nodes, root, cnf);
+
+  auto solver = Solver(cnf);
+  const auto satisfiable = solver.solve() == Solver::Result::Satisfiable;
+  mStatistics = solver.statistics();
+
+  auto answer = Answer(query, query == TokenType::Valid ? not satisfiable : satisfiable, {}, {});
+  if (satisfiable) {
+    const auto& names = nodes.variables();
+    for (size_t i = 0; i < names.size(); i++) {
+      answer.witness.emplace_back(names[i], solver.value(encoding.inputs[i]));
+    }
+  }
+  return answer;
+}
+
+auto Prover::countWithCounter(const NodeTable& nodes, NodeId root) -> Answer {
+  auto cnf = Cnf();
+  encode(TokenType::Count, nodes, root, cnf);
+
+  auto count = Counter(cnf).count();
+  const auto satisfiable = not count.isZero();
+  return Answer(TokenType::Count, satisfiable, {}, std::move(count));
+}
+
+auto Prover::exportDimacs(const Sentence::Query& query, std::FILE* file) -> std::expected<void, EvaluatorError> {
+  auto nodes = NodeTable();
+  const auto root = TRY(lower(*query.sentence, nodes));
+
+  // NOTE: the encoding is deterministic, so counting it first gives the header without keeping the
+  //       clauses around and the second pass numbers the variables the same way.
+  auto counter = ClauseCounter();
+  const auto encoding = encode(query.keyword.type, nodes, root, counter);
+
+  auto writer = DimacsWriter(file);
+  writer.comment(fmt::format("{} {}", query.keyword.lexeme, Sentence::asString(*query.sentence)));
+  const auto& names = nodes.variables();
+  for (size_t i = 0; i < names.size(); i++) {
+    writer.comment(fmt::format("input {} {}", names[i], encoding.inputs[i] + 1));
+  }
+  writer.header(counter.variables(), counter.clauses());
+  encode(query.keyword.type, nodes, root, writer);
+  return {};
+}
+
+auto Prover::encode(TokenType query, const NodeTable& nodes, NodeId root, ClauseSink& sink) -> Tseitin::Encoding {
+  // NOTE: the auxiliary variables of the full encoding are functions of the inputs, so it has as many
+  //       models as the sentence. The pruned one does not, and is only used to decide satisfiability.
+  if (query == TokenType::Count) {
+    auto encoding = Tseitin::encode(nodes, root, Tseitin::Polarity::Both, sink);
+    sink.addClause({encoding.root});
+    return encoding;
+  }
+
+  // NOTE: a sentence is valid iff its negation is unsatisfiable, the model is then a counterexample.
+  //       The root is only asserted in one polarity, so the pruned encoding is enough.
+  const auto isValidity = query == TokenType::Valid;
+  auto encoding = Tseitin::encode(nodes, root, isValidity ? Tseitin::Polarity::Negative : Tseitin::Polarity::Positive, sink);
+  sink.addClause({isValidity ? ~encoding.root : encoding.root});
+  return encoding;
+}
+
+auto Prover::proveWithBdd(TokenType query, const NodeTable& nodes, NodeId root) -> Answer {
+  auto bdd = Bdd(nodes.variables().size());
+  auto function = bdd.build(nodes, root);
+  if (query == TokenType::Count) {
+    auto count = bdd.count(function);
+    const auto satisfiable = not count.isZero();
+    return Answer(query, satisfiable, {}, std::move(count));
+  }
+
+  if (query == TokenType::Valid) {
+    function = Bdd::negation(function);
+  }
+
+  // NOTE: the diagram is canonical, a function is satisfiable iff it is not the constant false.
+  const auto satisfiable = function != Bdd::ZERO;
+  auto answer = Answer(query, query == TokenType::Valid ? not satisfiable : satisfiable, {}, {});
+  if (satisfiable) {
+    const auto& names = nodes.variables();
+    const auto assignment = bdd.satisfy(function);
+    for (size_t i = 0; i < names.size(); i++) {
+      answer.witness.emplace_back(names[i], assignment[i]);
+    }
+  }
+  return answer;
+}
+
+auto Prover::lower(const Sentence& sentence, NodeTable& nodes) -> std::expected<NodeId, EvaluatorError> {
+  auto error = std::optional<EvaluatorError>();
+  auto lowered = std::vector<NodeId>();
+  const auto pop = [&] {
+    const auto node = lowered.back();
+    lowered.pop_back();
+    return node;
+  };
+
+  // NOTE: a query does not change the environment, so assignments are not allowed inside it.
+  const auto enter = [&](const Sentence& sentence) {
+    if (error.has_value()) return false;
+    if (sentence.is<Sentence::Compound>() and sentence.unsafeAsRef<Sentence::Compound>().connective.type == TokenType::Equal) {
+      error = EvaluatorError::InvalidAssignment(sentence.location());
+      return false;
+    }
+    return true;
+  };
+
+  Sentence::walk(sentence, enter, [&](const Sentence& sentence) {
+    if (error.has_value()) return;
+    sentence.accept(overloaded {
+      [&](const Sentence::Variable& s) {
+        const auto name = s.identifier.lexeme;
+        if (mEnvironment.isVariableAssigned(name)) {
+          lowered.push_back(nodes.constant(mEnvironment.read(name, 0, 1).test(0)));
+        } else {
+          lowered.push_back(nodes.variable(name));
+        }
+      },
+      [&](const Sentence::Value& s) {
+        lowered.push_back(nodes.constant(s.value.type == TokenType::True));
+      },
+      [](const Sentence::Grouped&) {},
+      [](const Sentence::Query&) {},
+      [&](const Sentence::Negated&) {
+        lowered.push_back(nodes.negation(pop()));
+      },
+      [&](const Sentence::Compound& s) {
+        const auto right = pop();
+        const auto left = pop();
+        lowered.push_back(nodes.binary(NodeTable::kindOf(s.connective.type), left, right));
+      },
+    });
+  });
+
+  if (error.has_value()) return std::unexpected(*error);
+  return lowered.back();
+}
+
+auto Prover::backendToString(Backend backend) -> std::string_view {
+  switch (backend) {
+    case Backend::Sat:
+      return "sat";
+    case Backend::Bdd:
+      return "bdd";
+  }
+  std::unreachable();
+}
+
+auto Prover::backendFromString(std::string_view name) -> std::optional<Backend> {
+  for (auto backend : {Backend::Sat, Backend::Bdd}) {
+    if (backendToString(backend) == name) return backend;
+  }
+  return std::nullopt;
+}
+
+auto Prover::print(const Answer& answer) -> void {
+  if (answer.query == TokenType::Count) {
+    const auto count = answer.count.toString();
+    fmt::println(Output::out(), "{} {}", answer.holds ? Color::Green(count) : Color::Red(count), Color::Gray(answer.count == BigInt(1) ? "model" : "models"));
+    return;
+  }
+
+  const auto isValidity = answer.query == TokenType::Valid;
+
+  if (isValidity) {
+    fmt::println(Output::out(), "{}", answer.holds ? Color::Green("VALID") : Color::Red("NOT VALID"));
+  } else {
+    fmt::println(Output::out(), "{}", answer.holds ? Color::Green("SATISFIABLE") : Color::Red("UNSATISFIABLE"));
+  }
+
+  if (answer.witness.empty()) return;
+
+  std::string assignments;
+  for (const auto& [name, value] : answer.witness) {
+    if (not assignments.empty()) assignments += ", ";
+    assignments += fmt::format("{} = {}", name, value ? "T" : "F");
+  }
+  fmt::println(Output::out(), "{} {}", Color::Gray(isValidity ? "counterexample:" : "model:"), assignments);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdio>
+#include <expected>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "logic/evaluation/environment.h"
+#include "logic/evaluation/evaluator.h"
+#include "logic/evaluation/nodeTable.h"
+#include "logic/parsing/sentence.h"
+#include "logic/solver/solver.h"
+#include "logic/utils/bigInt.h"
+
+namespace logic {
+
+// The answer to a query, the witness is a model for `SAT` and a counterexample for `VALID`.
+struct Answer {
+  TokenType query;
+  bool holds;
+  std::vector<std::pair<std::string_view, bool>> witness;
+  // the number of models over the free variables of the sentence, only computed for `COUNT`.
+  BigInt count;
+};
+
+// Answers queries with the SAT solver or a BDD instead of enumerating the truth table, so they are
+// not bounded by `Environment::MAX_VARIABLES`. Assigned variables of the environment are constants.
+// With the SAT backend, `COUNT` queries are answered by the exact model counter.
+class Prover {
+
+public:
+  enum class Backend {
+    Sat,
+    Bdd,
+  };
+
+  static auto backendToString(Backend) -> std::string_view;
+  static auto backendFromString(std::string_view) -> std::optional<Backend>;
+
+private:
+  const Environment& mEnvironment;
+  Backend mBackend;
+  Solver::Statistics mStatistics;
+
+public:
+  explicit Prover(const Environment& environment, Backend backend = Backend::Sat)
+    : mEnvironment(environment), mBackend(backend) {}
+
+  auto prove(const Sentence::Query&) -> std::expected<Answer, EvaluatorError>;
+  static auto print(const Answer&) -> void;
+
+  // Writes the CNF the solver would be given in DIMACS format instead of solving it: satisfiable iff
+  // the query holds for `SAT`, and iff it does not for `VALID`. For `COUNT` the encoding is not pruned,
+  // so it has exactly as many models as the sentence.
+  auto exportDimacs(const Sentence::Query&, std::FILE*) -> std::expected<void, EvaluatorError>;
+
+  constexpr auto statistics() const -> const Solver::Statistics& {
+    return mStatistics;
+  }
+
+  // Interns a sentence into the node table the backends work on, assigned variables become constants.
+  auto lower(const Sentence&, NodeTable&) -> std::expected<NodeId, EvaluatorError>;
+
+private:
+  auto proveWithSolver(TokenType query, const NodeTable&, NodeId root) -> Answer;
+  auto proveWithBdd(TokenType query, const NodeTable&, NodeId root) -> Answer;
+  auto countWithCounter(const NodeTable&, NodeId root) -> Answer;
+
+  static auto encode(TokenType query, const NodeTable&, NodeId root, ClauseSink&) -> Tseitin::Encoding;
+};
+
+}
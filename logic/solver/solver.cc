@@ -0,0 +1,496 @@
+#include "logic/solver/solver.h"
+#include "logic/utils/macros.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+using namespace logic;
+
+namespace {
+
+constexpr auto VARIABLE_DECAY = 0.95;
+constexpr auto CLAUSE_DECAY = 0.999f;
+constexpr auto RESTART_INTERVAL = 100;
+constexpr auto LEARNT_GROWTH = 1.1;
+
+// The Luby sequence 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, ... scaled by the restart interval.
+auto luby(size_t index) -> size_t {
+  size_t size = 1;
+  size_t sequence = 0;
+  while (size < index + 1) {
+    sequence += 1;
+    size = 2 * size + 1;
+  }
+  while (size - 1 != index) {
+    size = (size - 1) >> 1;
+    sequence -= 1;
+    index = index % size;
+  }
+  return size_t(1) << sequence;
+}
+
+}
+
+Solver::Solver(const Cnf& cnf) {
+  const auto variables = cnf.variables();
+  mWatches.resize(2 * size_t(variables));
+  mAssigns.assign(variables, Truth::Undefined);
+  mLevel.assign(variables, 0);
+  mReason.assign(variables, NO_REASON);
+  mPhase.assign(variables, false);
+  mActivity.assign(variables, 0);
+  mHeapIndex.assign(variables, UINT32_MAX);
+  mSeen.assign(variables, 0);
+  mLevelStamp.assign(variables + 1, 0);
+
+  for (uint32_t variable = 0; variable < variables; variable++) {
+    heapInsert(variable);
+  }
+
+  for (size_t i = 0; i < cnf.clauses() and not mInconsistent; i++) {
+    addClause(cnf.clause(i));
+  }
+
+  mMaxLearnts = std::max<double>(double(cnf.clauses()) / 3, 2000);
+}
+
+auto Solver::addClause(std::span<const Literal> input) -> void {
+  auto clause = std::vector<Literal>(input.begin(), input.end());
+  std::ranges::sort(clause, {}, &Literal::code);
+  clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+
+  // NOTE: `x` and `¬x` are adjacent once sorted, such a clause is always satisfied.
+  for (size_t i = 1; i < clause.size(); i++) {
+    if (clause[i] == ~clause[i - 1]) return;
+  }
+
+  std::erase_if(clause, [this](Literal literal) { return valueOf(literal) == Truth::False; });
+  if (std::ranges::any_of(clause, [this](Literal literal) { return valueOf(literal) == Truth::True; })) {
+    return;
+  }
+
+  if (clause.empty()) {
+    mInconsistent = true;
+    return;
+  }
+
+  if (clause.size() == 1) {
+    enqueue(clause[0], NO_REASON);
+    mInconsistent = propagate() != NO_REASON;
+    return;
+  }
+
+  mClauses.emplace_back(mArena.size(), uint32_t(clause.size()), 0, 0.0f, false, false);
+  mArena.insert(mArena.end(), clause.begin(), clause.end());
+  attach(mClauses.size() - 1);
+}
+
+auto Solver::attach(uint32_t clause) -> void {
+  const auto* literals = mArena.data() + mClauses[clause].start;
+  mWatches[literals[0].code].emplace_back(clause, literals[1]);
+  mWatches[literals[1].code].emplace_back(clause, literals[0]);
+}
+
+auto Solver::enqueue(Literal literal, uint32_t reason) -> void {
+  const auto variable = literal.variable();
+  mAssigns[variable] = literal.isNegated() ? Truth::False : Truth::True;
+  mLevel[variable] = decisionLevel();
+  mReason[variable] = reason;
+  mTrail.push_back(literal);
+}
+
+// Returns the clause that became false, or `NO_REASON` if every implication was propagated.
+auto Solver::propagate() -> uint32_t {
+  auto conflict = NO_REASON;
+
+  while (mPropagated < mTrail.size()) {
+    const auto falsified = ~mTrail[mPropagated++];
+    auto& watches = mWatches[falsified.code];
+    mStatistics.propagations += 1;
+
+    size_t i = 0, j = 0;
+    while (i < watches.size()) {
+      const auto watcher = watches[i++];
+      if (valueOf(watcher.blocker) == Truth::True) {
+        watches[j++] = watcher;
+        continue;
+      }
+
+      auto& clause = mClauses[watcher.clause];
+      auto* literals = this->literals(clause);
+
+      // NOTE: the falsified literal is kept at index 1, so index 0 is the other watch.
+      if (literals[0] == falsified) {
+        std::swap(literals[0], literals[1]);
+      }
+
+      const auto first = literals[0];
+      const auto updated = Watcher(watcher.clause, first);
+      if (first != watcher.blocker and valueOf(first) == Truth::True) {
+        watches[j++] = updated;
+        continue;
+      }
+
+      bool moved = false;
+      for (uint32_t k = 2; k < clause.size; k++) {
+        if (valueOf(literals[k]) != Truth::False) {
+          std::swap(literals[1], literals[k]);
+          mWatches[literals[1].code].push_back(updated);
+          moved = true;
+          break;
+        }
+      }
+      if (moved) continue;
+
+      watches[j++] = updated;
+      if (valueOf(first) == Truth::False) {
+        conflict = watcher.clause;
+        mPropagated = mTrail.size();
+        while (i < watches.size()) {
+          watches[j++] = watches[i++];
+        }
+      } else {
+        enqueue(first, watcher.clause);
+      }
+    }
+    watches.resize(j);
+  }
+
+  return conflict;
+}
+
+// Derives the first-UIP clause of a conflict, returns the level to backtrack to.
+// The asserting literal is placed first and a literal of the backtrack level second.
+auto Solver::analyze(uint32_t conflict, std::vector<Literal>& learnt) -> uint32_t {
+  learnt.clear();
+  learnt.push_back(Literal(0));
+
+  size_t pending = 0;
+  size_t index = mTrail.size();
+  auto implied = std::optional<Literal>();
+
+  do {
+    auto& clause = mClauses[conflict];
+    if (clause.learnt) bump(clause);
+
+    const auto* literals = this->literals(clause);
+    for (uint32_t k = implied.has_value() ? 1 : 0; k < clause.size; k++) {
+      const auto literal = literals[k];
+      const auto variable = literal.variable();
+      if (mSeen[variable] or mLevel[variable] == 0) continue;
+
+      bump(variable);
+      mSeen[variable] = 1;
+      if (mLevel[variable] >= decisionLevel()) {
+        pending += 1;
+      } else {
+        learnt.push_back(literal);
+      }
+    }
+
+    while (not mSeen[mTrail[--index].variable()]);
+    implied = mTrail[index];
+    conflict = mReason[implied->variable()];
+    mSeen[implied->variable()] = 0;
+    pending -= 1;
+  } while (pending > 0);
+
+  learnt[0] = ~*implied;
+
+  // NOTE: a literal implied only by other literals of the clause adds nothing to it.
+  mRedundant.clear();
+  size_t kept = 1;
+  for (size_t i = 1; i < learnt.size(); i++) {
+    if (isRedundant(learnt[i])) {
+      mRedundant.push_back(learnt[i]);
+    } else {
+      learnt[kept++] = learnt[i];
+    }
+  }
+  learnt.resize(kept);
+  for (const auto literal : learnt) {
+    mSeen[literal.variable()] = 0;
+  }
+  for (const auto literal : mRedundant) {
+    mSeen[literal.variable()] = 0;
+  }
+
+  if (learnt.size() == 1) {
+    return 0;
+  }
+
+  size_t highest = 1;
+  for (size_t i = 2; i < learnt.size(); i++) {
+    if (mLevel[learnt[i].variable()] > mLevel[learnt[highest].variable()]) {
+      highest = i;
+    }
+  }
+  std::swap(learnt[1], learnt[highest]);
+  return mLevel[learnt[1].variable()];
+}
+
+auto Solver::isRedundant(Literal literal) const -> bool {
+  const auto reason = mReason[literal.variable()];
+  if (reason == NO_REASON) return false;
+
+  const auto& clause = mClauses[reason];
+  const auto* literals = mArena.data() + clause.start;
+  for (uint32_t k = 1; k < clause.size; k++) {
+    const auto variable = literals[k].variable();
+    if (not mSeen[variable] and mLevel[variable] > 0) return false;
+  }
+  return true;
+}
+
+auto Solver::backtrack(uint32_t level) -> void {
+  if (decisionLevel() <= level) return;
+
+  for (auto i = mTrail.size(); i-- > mTrailLimits[level];) {
+    const auto variable = mTrail[i].variable();
+    mPhase[variable] = not mTrail[i].isNegated();
+    mAssigns[variable] = Truth::Undefined;
+    mReason[variable] = NO_REASON;
+    if (mHeapIndex[variable] == UINT32_MAX) heapInsert(variable);
+  }
+  mTrail.resize(mTrailLimits[level]);
+  mTrailLimits.resize(level);
+  mPropagated = mTrail.size();
+}
+
+// Assigns the unassigned variable with the highest activity to its saved phase, false if none is left.
+auto Solver::decide() -> bool {
+  while (not mHeap.empty()) {
+    const auto variable = heapPop();
+    if (mAssigns[variable] != Truth::Undefined) continue;
+
+    mStatistics.decisions += 1;
+    mTrailLimits.push_back(mTrail.size());
+    enqueue(mPhase[variable] ? Literal::positive(variable) : Literal::negative(variable), NO_REASON);
+    return true;
+  }
+  return false;
+}
+
+auto Solver::solve() -> Result {
+  return solve({});
+}
+
+auto Solver::solve(std::span<const Literal> assumptions) -> Result {
+  if (mInconsistent) return Result::Unsatisfiable;
+
+  backtrack(0);
+  if (propagate() != NO_REASON) {
+    mInconsistent = true;
+    return Result::Unsatisfiable;
+  }
+
+  std::vector<Literal> learnt;
+  size_t restarts = 0;
+  size_t conflicts = 0;
+
+  while (true) {
+    const auto conflict = propagate();
+    if (conflict != NO_REASON) {
+      mStatistics.conflicts += 1;
+      if (decisionLevel() == 0) {
+        mInconsistent = true;
+        return Result::Unsatisfiable;
+      }
+
+      const auto level = analyze(conflict, learnt);
+      backtrack(level);
+
+      if (learnt.size() == 1) {
+        enqueue(learnt[0], NO_REASON);
+      } else {
+        mStamp += 1;
+        uint32_t lbd = 0;
+        for (const auto literal : learnt) {
+          auto& stamp = mLevelStamp[mLevel[literal.variable()]];
+          if (stamp != mStamp) {
+            stamp = mStamp;
+            lbd += 1;
+          }
+        }
+
+        const auto clause = uint32_t(mClauses.size());
+        mClauses.emplace_back(mArena.size(), uint32_t(learnt.size()), lbd, 0.0f, true, false);
+        mArena.insert(mArena.end(), learnt.begin(), learnt.end());
+        mLearnts.push_back(clause);
+        attach(clause);
+        bump(mClauses[clause]);
+        enqueue(learnt[0], clause);
+        mStatistics.learnt += 1;
+      }
+
+      decay();
+      conflicts += 1;
+      continue;
+    }
+
+    if (conflicts >= luby(restarts) * RESTART_INTERVAL) {
+      mStatistics.restarts += 1;
+      restarts += 1;
+      conflicts = 0;
+      backtrack(0);
+      continue;
+    }
+
+    if (decisionLevel() == 0 and double(mLearnts.size()) >= mMaxLearnts) {
+      reduce();
+      mMaxLearnts *= LEARNT_GROWTH;
+    }
+
+    // NOTE: every assumption gets its own decision level, so that a conflict that only depends on
+    //       them backtracks above them instead of refuting the formula.
+    if (decisionLevel() < assumptions.size()) {
+      const auto assumption = assumptions[decisionLevel()];
+      const auto truth = valueOf(assumption);
+      if (truth == Truth::False) {
+        backtrack(0);
+        return Result::Unsatisfiable;
+      }
+      mTrailLimits.push_back(mTrail.size());
+      if (truth == Truth::Undefined) {
+        enqueue(assumption, NO_REASON);
+      }
+      continue;
+    }
+
+    if (not decide()) {
+      mModel.resize(mAssigns.size());
+      for (size_t variable = 0; variable < mAssigns.size(); variable++) {
+        mModel[variable] = mAssigns[variable] == Truth::True;
+      }
+      backtrack(0);
+      return Result::Satisfiable;
+    }
+  }
+}
+
+// Removes half of the learnt clauses, those with the highest LBD and lowest activity go first.
+// Glue clauses (LBD of 2) and clauses that are the reason of an assignment are always kept.
+auto Solver::reduce() -> void {
+  std::ranges::sort(mLearnts, [this](uint32_t a, uint32_t b) {
+    const auto& x = mClauses[a];
+    const auto& y = mClauses[b];
+    if (x.lbd != y.lbd) return x.lbd > y.lbd;
+    return x.activity < y.activity;
+  });
+
+  const auto limit = mLearnts.size() / 2;
+  for (size_t i = 0; i < limit; i++) {
+    auto& clause = mClauses[mLearnts[i]];
+    if (clause.lbd > 2 and not isLocked(mLearnts[i])) {
+      clause.deleted = true;
+    }
+  }
+
+  // NOTE: the arena is compacted and every reference to a clause is renumbered at once, this is
+  //       cheaper than unlinking clauses from the watch lists one by one.
+  std::vector<uint32_t> renumbered(mClauses.size(), NO_REASON);
+  std::vector<Clause> clauses;
+  std::vector<Literal> arena;
+  for (uint32_t i = 0; i < mClauses.size(); i++) {
+    auto clause = mClauses[i];
+    if (clause.deleted) continue;
+
+    renumbered[i] = uint32_t(clauses.size());
+    const auto* literals = this->literals(mClauses[i]);
+    clause.start = arena.size();
+    arena.insert(arena.end(), literals, literals + clause.size);
+    clauses.push_back(clause);
+  }
+
+  mClauses = std::move(clauses);
+  mArena = std::move(arena);
+
+  std::erase_if(mLearnts, [&](uint32_t& clause) {
+    clause = renumbered[clause];
+    return clause == NO_REASON;
+  });
+  for (auto& reason : mReason) {
+    if (reason != NO_REASON) reason = renumbered[reason];
+  }
+  for (auto& watches : mWatches) {
+    watches.clear();
+  }
+  for (uint32_t i = 0; i < mClauses.size(); i++) {
+    attach(i);
+  }
+}
+
+auto Solver::bump(uint32_t variable) -> void {
+  mActivity[variable] += mVariableIncrement;
+  if (mActivity[variable] > 1e100) {
+    for (auto& activity : mActivity) {
+      activity *= 1e-100;
+    }
+    mVariableIncrement *= 1e-100;
+  }
+  if (mHeapIndex[variable] != UINT32_MAX) {
+    heapUp(mHeapIndex[variable]);
+  }
+}
+
+auto Solver::bump(Clause& clause) -> void {
+  clause.activity += mClauseIncrement;
+  if (clause.activity > 1e20f) {
+    for (auto learnt : mLearnts) {
+      mClauses[learnt].activity *= 1e-20f;
+    }
+    mClauseIncrement *= 1e-20f;
+  }
+}
+
+auto Solver::decay() -> void {
+  mVariableIncrement /= VARIABLE_DECAY;
+  mClauseIncrement /= CLAUSE_DECAY;
+}
+
+auto Solver::heapInsert(uint32_t variable) -> void {
+  mHeapIndex[variable] = mHeap.size();
+  mHeap.push_back(variable);
+  heapUp(mHeap.size() - 1);
+}
+
+auto Solver::heapPop() -> uint32_t {
+  const auto top = mHeap.front();
+  mHeap.front() = mHeap.back();
+  mHeapIndex[mHeap.front()] = 0;
+  mHeap.pop_back();
+  mHeapIndex[top] = UINT32_MAX;
+  if (not mHeap.empty()) heapDown(0);
+  return top;
+}
+
+auto Solver::heapUp(size_t index) -> void {
+  const auto variable = mHeap[index];
+  while (index > 0) {
+    const auto parent = (index - 1) / 2;
+    if (mActivity[mHeap[parent]] >= mActivity[variable]) break;
+    mHeap[index] = mHeap[parent];
+    mHeapIndex[mHeap[index]] = index;
+    index = parent;
+  }
+  mHeap[index] = variable;
+  mHeapIndex[variable] = index;
+}
+
+auto Solver::heapDown(size_t index) -> void {
+  const auto variable = mHeap[index];
+  while (true) {
+    auto child = 2 * index + 1;
+    if (child >= mHeap.size()) break;
+    if (child + 1 < mHeap.size() and mActivity[mHeap[child + 1]] > mActivity[mHeap[child]]) {
+      child += 1;
+    }
+    if (mActivity[mHeap[child]] <= mActivity[variable]) break;
+    mHeap[index] = mHeap[child];
+    mHeapIndex[mHeap[index]] = index;
+    index = child;
+  }
+  mHeap[index] = variable;
+  mHeapIndex[variable] = index;
+}
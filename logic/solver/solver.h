@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "logic/solver/cnf.h"
+
+namespace logic {
+
+// A conflict-driven clause-learning SAT solver.
+//
+// Clauses are propagated with two watched literals, decisions follow VSIDS activity with phase saving,
+// conflicts are analysed up to the first unique implication point and the solver restarts following
+// the Luby sequence. Learnt clauses are periodically reduced, keeping those with a small LBD.
+class Solver {
+
+public:
+  enum class Result {
+    Satisfiable,
+    Unsatisfiable,
+  };
+
+  struct Statistics {
+    size_t decisions = 0;
+    size_t propagations = 0;
+    size_t conflicts = 0;
+    size_t restarts = 0;
+    size_t learnt = 0;
+  };
+
+private:
+  enum class Truth : uint8_t {
+    False,
+    True,
+    Undefined,
+  };
+
+  struct Clause {
+    size_t start;
+    uint32_t size;
+    uint32_t lbd;
+    float activity;
+    bool learnt;
+    bool deleted;
+  };
+
+  struct Watcher {
+    uint32_t clause;
+    // a literal of the clause, if it is true the clause does not need to be visited.
+    Literal blocker;
+  };
+
+  static constexpr auto NO_REASON = UINT32_MAX;
+
+  std::vector<Literal> mArena;
+  std::vector<Clause> mClauses;
+  std::vector<uint32_t> mLearnts;
+  std::vector<std::vector<Watcher>> mWatches;
+
+  std::vector<Truth> mAssigns;
+  std::vector<uint32_t> mLevel;
+  std::vector<uint32_t> mReason;
+  std::vector<bool> mPhase;
+  std::vector<Literal> mTrail;
+  std::vector<size_t> mTrailLimits;
+  size_t mPropagated = 0;
+
+  std::vector<double> mActivity;
+  std::vector<uint32_t> mHeap;
+  std::vector<uint32_t> mHeapIndex;
+  double mVariableIncrement = 1;
+  float mClauseIncrement = 1;
+
+  std::vector<uint8_t> mSeen;
+  std::vector<Literal> mRedundant;
+  std::vector<uint32_t> mLevelStamp;
+  uint32_t mStamp = 0;
+
+  std::vector<bool> mModel;
+  double mMaxLearnts = 0;
+  bool mInconsistent = false;
+  Statistics mStatistics;
+
+public:
+  explicit Solver(const Cnf&);
+
+  auto solve() -> Result;
+  // Solves under the assumption that every given literal is true, learnt clauses are kept between calls.
+  auto solve(std::span<const Literal> assumptions) -> Result;
+
+  // The value of a variable in the model found by the last satisfiable call to `solve`.
+  auto value(uint32_t variable) const -> bool {
+    return mModel[variable];
+  }
+
+  constexpr auto statistics() const -> const Statistics& {
+    return mStatistics;
+  }
+
+private:
+  auto addClause(std::span<const Literal>) -> void;
+  auto attach(uint32_t clause) -> void;
+
+  auto propagate() -> uint32_t;
+  auto analyze(uint32_t conflict, std::vector<Literal>& learnt) -> uint32_t;
+  auto isRedundant(Literal) const -> bool;
+  auto enqueue(Literal, uint32_t reason) -> void;
+  auto backtrack(uint32_t level) -> void;
+  auto decide() -> bool;
+  auto reduce() -> void;
+
+  auto bump(uint32_t variable) -> void;
+  auto bump(Clause&) -> void;
+  auto decay() -> void;
+
+  auto heapInsert(uint32_t variable) -> void;
+  auto heapPop() -> uint32_t;
+  auto heapUp(size_t index) -> void;
+  auto heapDown(size_t index) -> void;
+
+  constexpr auto literals(const Clause& clause) -> Literal* {
+    return mArena.data() + clause.start;
+  }
+
+  constexpr auto valueOf(Literal literal) const -> Truth {
+    auto truth = mAssigns[literal.variable()];
+    if (truth == Truth::Undefined) return truth;
+    return Truth(uint8_t(truth) ^ uint8_t(literal.isNegated()));
+  }
+
+  constexpr auto decisionLevel() const -> uint32_t {
+    return mTrailLimits.size();
+  }
+
+  constexpr auto isLocked(uint32_t clause) const -> bool {
+    auto first = mArena[mClauses[clause].start];
+    return mReason[first.variable()] == clause and valueOf(first) == Truth::True;
+  }
+};
+
+}
@@ -0,0 +1,36 @@
+// Replaces the global allocation functions so that `--stats` can count the allocations of every
+// phase. It is only linked into the `logic` executable, the tests and benchmarks use the default ones.
+
+#include "logic/utils/profiler.h"
+
+#include <cstdlib>
+#include <new>
+
+using namespace logic;
+
+// NOTE: exceptions are disabled, so running out of memory aborts instead of throwing `std::bad_alloc`.
+auto operator new(size_t size) -> void* {
+  Profiler::countAllocation();
+  if (auto* pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+  std::abort();
+}
+
+auto operator new[](size_t size) -> void* {
+  return ::operator new(size);
+}
+
+auto operator delete(void* pointer) noexcept -> void {
+  std::free(pointer);
+}
+
+auto operator delete[](void* pointer) noexcept -> void {
+  std::free(pointer);
+}
+
+auto operator delete(void* pointer, size_t) noexcept -> void {
+  std::free(pointer);
+}
+
+auto operator delete[](void* pointer, size_t) noexcept -> void {
+  std::free(pointer);
+}
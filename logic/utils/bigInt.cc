@@ -0,0 +1,137 @@
+#include "logic/utils/bigInt.h"
+
+#include <algorithm>
+
+using namespace logic;
+
+BigInt::BigInt(uint64_t value) {
+  while (value != 0) {
+    mLimbs.push_back(uint32_t(value));
+    value >>= 32;
+  }
+}
+
+auto BigInt::powerOfTwo(size_t exponent) -> BigInt {
+  return BigInt(1) << exponent;
+}
+
+auto BigInt::operator+=(const BigInt& other) -> BigInt& {
+  if (mLimbs.size() < other.mLimbs.size()) {
+    mLimbs.resize(other.mLimbs.size(), 0);
+  }
+
+  uint64_t carry = 0;
+  for (size_t i = 0; i < mLimbs.size(); i++) {
+    if (i >= other.mLimbs.size() and carry == 0) break;
+    const auto sum = uint64_t(mLimbs[i]) + (i < other.mLimbs.size() ? other.mLimbs[i] : 0) + carry;
+    mLimbs[i] = uint32_t(sum);
+    carry = sum >> 32;
+  }
+  if (carry != 0) {
+    mLimbs.push_back(uint32_t(carry));
+  }
+  return *this;
+}
+
+auto BigInt::operator-=(const BigInt& other) -> BigInt& {
+  int64_t borrow = 0;
+  for (size_t i = 0; i < mLimbs.size(); i++) {
+    if (i >= other.mLimbs.size() and borrow == 0) break;
+    auto difference = int64_t(mLimbs[i]) - (i < other.mLimbs.size() ? other.mLimbs[i] : 0) - borrow;
+    borrow = difference < 0;
+    mLimbs[i] = uint32_t(difference + (borrow << 32));
+  }
+  trim();
+  return *this;
+}
+
+auto BigInt::operator*=(const BigInt& other) -> BigInt& {
+  if (isZero() or other.isZero()) {
+    mLimbs.clear();
+    return *this;
+  }
+
+  auto product = std::vector<uint32_t>(mLimbs.size() + other.mLimbs.size(), 0);
+  for (size_t i = 0; i < mLimbs.size(); i++) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < other.mLimbs.size(); j++) {
+      const auto current = uint64_t(mLimbs[i]) * other.mLimbs[j] + product[i + j] + carry;
+      product[i + j] = uint32_t(current);
+      carry = current >> 32;
+    }
+    product[i + other.mLimbs.size()] = uint32_t(carry);
+  }
+
+  mLimbs = std::move(product);
+  trim();
+  return *this;
+}
+
+auto BigInt::operator<<=(size_t bits) -> BigInt& {
+  if (isZero()) return *this;
+
+  const auto limbs = bits / 32;
+  const auto shift = bits % 32;
+  if (shift != 0) {
+    uint32_t carry = 0;
+    for (auto& limb : mLimbs) {
+      const auto next = limb >> (32 - shift);
+      limb = (limb << shift) | carry;
+      carry = next;
+    }
+    if (carry != 0) {
+      mLimbs.push_back(carry);
+    }
+  }
+  mLimbs.insert(mLimbs.begin(), limbs, 0);
+  return *this;
+}
+
+namespace logic {
+
+auto operator<=>(const BigInt& lhs, const BigInt& rhs) -> std::strong_ordering {
+  if (lhs.mLimbs.size() != rhs.mLimbs.size()) {
+    return lhs.mLimbs.size() <=> rhs.mLimbs.size();
+  }
+  for (auto i = lhs.mLimbs.size(); i-- > 0;) {
+    if (lhs.mLimbs[i] != rhs.mLimbs[i]) {
+      return lhs.mLimbs[i] <=> rhs.mLimbs[i];
+    }
+  }
+  return std::strong_ordering::equal;
+}
+
+}
+
+auto BigInt::toString() const -> std::string {
+  if (isZero()) return "0";
+
+  // NOTE: dividing by 10^9 at a time produces nine decimal digits per pass over the limbs.
+  static constexpr uint32_t CHUNK = 1'000'000'000;
+  auto limbs = mLimbs;
+  std::string digits;
+  while (not limbs.empty()) {
+    uint64_t remainder = 0;
+    for (auto i = limbs.size(); i-- > 0;) {
+      const auto current = (remainder << 32) | limbs[i];
+      limbs[i] = uint32_t(current / CHUNK);
+      remainder = current % CHUNK;
+    }
+    while (not limbs.empty() and limbs.back() == 0) {
+      limbs.pop_back();
+    }
+    for (int i = 0; i < 9; i++) {
+      digits.push_back(char('0' + remainder % 10));
+      remainder /= 10;
+      if (limbs.empty() and remainder == 0) break;
+    }
+  }
+  std::ranges::reverse(digits);
+  return digits;
+}
+
+auto BigInt::trim() -> void {
+  while (not mLimbs.empty() and mLimbs.back() == 0) {
+    mLimbs.pop_back();
+  }
+}
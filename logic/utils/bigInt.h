@@ -0,0 +1,48 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace logic {
+
+// An arbitrary-precision unsigned integer, used for model counts that do not fit in 64 bits.
+// The limbs are little-endian and the most significant limb is never zero.
+class BigInt {
+
+private:
+  std::vector<uint32_t> mLimbs;
+
+public:
+  BigInt() = default;
+  BigInt(uint64_t value);
+
+  static auto powerOfTwo(size_t exponent) -> BigInt;
+
+  auto operator+=(const BigInt&) -> BigInt&;
+  // NOTE: the result would be negative otherwise, so the right-hand side must not be larger.
+  auto operator-=(const BigInt&) -> BigInt&;
+  auto operator*=(const BigInt&) -> BigInt&;
+  auto operator<<=(size_t bits) -> BigInt&;
+
+  friend auto operator+(BigInt lhs, const BigInt& rhs) -> BigInt { return lhs += rhs; }
+  friend auto operator-(BigInt lhs, const BigInt& rhs) -> BigInt { return lhs -= rhs; }
+  friend auto operator*(BigInt lhs, const BigInt& rhs) -> BigInt { return lhs *= rhs; }
+  friend auto operator<<(BigInt lhs, size_t bits) -> BigInt { return lhs <<= bits; }
+
+  friend auto operator==(const BigInt&, const BigInt&) -> bool = default;
+  friend auto operator<=>(const BigInt&, const BigInt&) -> std::strong_ordering;
+
+  constexpr auto isZero() const -> bool {
+    return mLimbs.empty();
+  }
+
+  auto toString() const -> std::string;
+
+private:
+  auto trim() -> void;
+};
+
+}
@@ -0,0 +1,27 @@
+#include "logic/utils/lineIndex.h"
+
+#include <cstring>
+
+using namespace logic;
+
+auto LineIndex::line(size_t nth) const -> std::string_view {
+  std::call_once(mIndexed, [this] {
+    mStarts.push_back(0);
+    const auto* data = mSource.data();
+    const auto* end = data + mSource.size();
+    for (const auto* current = data; current < end;) {
+      const auto* newline = static_cast<const char*>(std::memchr(current, '\n', size_t(end - current)));
+      if (newline == nullptr) break;
+      current = newline + 1;
+      mStarts.push_back(size_t(current - data));
+    }
+    mStarts.push_back(mSource.size() + 1);
+  });
+
+  // NOTE: a source that ends with a line break has no line after it.
+  if (nth == 0 or nth >= mStarts.size()) return "";
+  const auto start = mStarts[nth - 1];
+  const auto end = mStarts[nth] - 1;
+  if (start >= mSource.size()) return "";
+  return mSource.substr(start, end - start);
+}
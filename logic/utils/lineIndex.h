@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace logic {
+
+// The offset of every line of a source, so that reporting an error finds the line it is at without
+// splitting the source again. The offsets are only found the first time a line is asked for, runs
+// without errors never pay for them. Lines can be asked for from several threads at once.
+class LineIndex {
+
+private:
+  std::string_view mSource;
+  mutable std::once_flag mIndexed;
+  // where every line starts, and one past the end of the source.
+  mutable std::vector<size_t> mStarts;
+
+public:
+  explicit LineIndex(std::string_view source) : mSource(source) {}
+
+  LineIndex(const LineIndex&) = delete;
+  auto operator=(const LineIndex&) -> LineIndex& = delete;
+
+  // The `nth` line of the source counting from 1 without its line break, or an empty line if there is none.
+  auto line(size_t nth) const -> std::string_view;
+};
+
+}
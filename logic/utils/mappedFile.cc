@@ -0,0 +1,46 @@
+#include "logic/utils/mappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+using namespace logic;
+
+auto MappedFile::open(std::string_view path) -> std::optional<MappedFile> {
+  const auto descriptor = ::open(std::string(path).c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return std::nullopt;
+  }
+
+  struct stat status;
+  if (::fstat(descriptor, &status) != 0 or not S_ISREG(status.st_mode)) {
+    ::close(descriptor);
+    return std::nullopt;
+  }
+
+  const auto size = size_t(status.st_size);
+  if (size == 0) {
+    ::close(descriptor);
+    return MappedFile(nullptr, 0);
+  }
+
+  auto* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  // NOTE: the mapping stays valid after the descriptor is closed.
+  ::close(descriptor);
+  if (data == MAP_FAILED) {
+    return std::nullopt;
+  }
+
+  // NOTE: the scanner reads the source once from start to end.
+  ::madvise(data, size, MADV_SEQUENTIAL);
+  return MappedFile(static_cast<const char*>(data), size);
+}
+
+MappedFile::~MappedFile() {
+  if (mData != nullptr) {
+    ::munmap(const_cast<char*>(mData), mSize);
+  }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace logic {
+
+// A file mapped read-only into memory, so its contents can be scanned in place without being copied.
+// The mapping lives as long as the object, views into `contents` must not outlive it.
+class MappedFile {
+
+private:
+  const char* mData = nullptr;
+  size_t mSize = 0;
+
+  MappedFile(const char* data, size_t size) : mData(data), mSize(size) {}
+
+public:
+  // NOTE: empty files cannot be mapped, they are opened with empty contents.
+  static auto open(std::string_view path) -> std::optional<MappedFile>;
+
+  MappedFile(MappedFile&& other) noexcept : mData(other.mData), mSize(other.mSize) {
+    other.mData = nullptr;
+    other.mSize = 0;
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  auto operator=(const MappedFile&) -> MappedFile& = delete;
+  auto operator=(MappedFile&&) -> MappedFile& = delete;
+
+  ~MappedFile();
+
+  constexpr auto contents() const -> std::string_view {
+    return std::string_view(mData == nullptr ? "" : mData, mSize);
+  }
+};
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdio>
+
+namespace logic {
+
+// The streams results and diagnostics are printed to. They are the standard streams unless the
+// current thread redirects them, which is how batch mode collects the output of every shard on its
+// worker and prints it in source order.
+class Output {
+
+private:
+  struct Streams {
+    std::FILE* out;
+    std::FILE* err;
+  };
+
+  static auto streams() -> Streams& {
+    static thread_local auto current = Streams(stdout, stderr);
+    return current;
+  }
+
+public:
+  static auto out() -> std::FILE* {
+    return streams().out;
+  }
+
+  static auto err() -> std::FILE* {
+    return streams().err;
+  }
+
+  // Redirects the streams of the current thread for as long as it lives.
+  class Redirect {
+
+  private:
+    Streams mPrevious;
+
+  public:
+    Redirect(std::FILE* out, std::FILE* err) : mPrevious(streams()) {
+      streams() = Streams(out, err);
+    }
+
+    ~Redirect() {
+      streams() = mPrevious;
+    }
+
+    Redirect(const Redirect&) = delete;
+    auto operator=(const Redirect&) -> Redirect& = delete;
+  };
+};
+
+}
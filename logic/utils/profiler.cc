@@ -0,0 +1,96 @@
+#include "logic/utils/profiler.h"
+
+#include <fmt/core.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+using namespace logic;
+
+namespace {
+
+// NOTE: everything but the flag and the allocation counter is only touched by measured spans.
+std::mutex sMutex;
+std::array<Profiler::Statistics, Profiler::PHASES> sStatistics;
+std::FILE* sTrace = nullptr;
+size_t sEvents = 0;
+std::chrono::steady_clock::time_point sEpoch;
+
+// Small ids in the order threads first finish a span, the trace viewer shows one track per id.
+auto threadId() -> size_t {
+  static std::atomic<size_t> next = 0;
+  static thread_local const auto id = next++;
+  return id;
+}
+
+auto escape(std::string_view text) -> std::string {
+  auto escaped = std::string();
+  escaped.reserve(text.size());
+  for (auto c : text) {
+    if (c == '"' or c == '\\') escaped.push_back('\\');
+    escaped.push_back(c);
+  }
+  return escaped;
+}
+
+}
+
+auto Profiler::Span::finish() -> void {
+  const auto end = std::chrono::steady_clock::now();
+  const auto allocations = tAllocations - mAllocations;
+  const auto nanoseconds = size_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - mStart).count());
+
+  const auto lock = std::lock_guard(sMutex);
+  auto& statistics = sStatistics[size_t(mPhase)];
+  statistics.spans++;
+  statistics.nanoseconds += nanoseconds;
+  statistics.allocations += allocations;
+  statistics.rows += mRows;
+  statistics.nodes += mNodes;
+
+  if (sTrace == nullptr) return;
+
+  // NOTE: complete events (`"ph":"X"`) carry their duration, timestamps are in microseconds.
+  const auto timestamp = std::chrono::duration<double, std::micro>(mStart - sEpoch).count();
+  const auto phase = phaseToString(mPhase);
+  fmt::print(sTrace,
+      "{}\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{},"
+      "\"args\":{{\"allocations\":{},\"rows\":{},\"nodes\":{}}}}}",
+      sEvents++ == 0 ? "" : ",", mName.empty() ? std::string(phase) : escape(mName), phase, timestamp,
+      double(nanoseconds) / 1000, threadId(), allocations, mRows, mNodes);
+}
+
+auto Profiler::start(bool statistics, std::FILE* trace) -> void {
+  if (not statistics and trace == nullptr) return;
+
+  const auto lock = std::lock_guard(sMutex);
+  sStatistics = {};
+  sTrace = trace;
+  sEvents = 0;
+  sEpoch = std::chrono::steady_clock::now();
+  if (sTrace != nullptr) fmt::print(sTrace, "{{\"traceEvents\":[");
+  sEnabled.store(true, std::memory_order_relaxed);
+}
+
+auto Profiler::stop() -> void {
+  const auto lock = std::lock_guard(sMutex);
+  sEnabled.store(false, std::memory_order_relaxed);
+  if (sTrace != nullptr) {
+    fmt::print(sTrace, "\n],\"displayTimeUnit\":\"ms\"}}\n");
+    std::fflush(sTrace);
+  }
+  sTrace = nullptr;
+}
+
+auto Profiler::report(std::FILE* file) -> void {
+  const auto lock = std::lock_guard(sMutex);
+  fmt::println(file, "{:<10} {:>8} {:>12} {:>12} {:>14} {:>12}", "phase", "spans", "time (ms)", "allocations", "rows", "nodes");
+  for (size_t phase = 0; phase < PHASES; phase++) {
+    const auto& statistics = sStatistics[phase];
+    if (statistics.spans == 0) continue;
+    fmt::println(file, "{:<10} {:>8} {:>12.3f} {:>12} {:>14} {:>12}", phaseToString(Phase(phase)), statistics.spans,
+                 double(statistics.nanoseconds) / 1e6, statistics.allocations, statistics.rows, statistics.nodes);
+  }
+  sStatistics = {};
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace logic {
+
+// Measures the phases of a run: the wall time, allocations, rows and nodes of every phase are summed
+// up for `--stats`, and every span is written as a Chrome trace event for `--trace`, which can be
+// opened in `chrome://tracing` or Perfetto.
+//
+// Nothing is measured until `start` is called, until then a span only checks a flag.
+class Profiler {
+
+public:
+  enum class Phase : uint8_t {
+    Sentence,
+    Scan,
+    Parse,
+    Simplify,
+    Compile,
+    Evaluate,
+    Print,
+    Prove,
+  };
+
+  static constexpr size_t PHASES = 8;
+
+  struct Statistics {
+    size_t spans = 0;
+    size_t nanoseconds = 0;
+    size_t allocations = 0;
+    size_t rows = 0;
+    size_t nodes = 0;
+  };
+
+  // Measures its phase from its construction to its destruction, on the thread it was created on.
+  class Span {
+
+  private:
+    bool mActive;
+    Phase mPhase;
+    std::chrono::steady_clock::time_point mStart;
+    size_t mAllocations = 0;
+    size_t mRows = 0;
+    size_t mNodes = 0;
+    std::string mName;
+
+  public:
+    explicit Span(Phase phase) : mActive(enabled()), mPhase(phase) {
+      if (not mActive) return;
+      mAllocations = tAllocations;
+      mStart = std::chrono::steady_clock::now();
+    }
+
+    ~Span() {
+      if (mActive) finish();
+    }
+
+    Span(const Span&) = delete;
+    auto operator=(const Span&) -> Span& = delete;
+
+    constexpr auto rows(size_t rows) -> void {
+      mRows += rows;
+    }
+
+    constexpr auto nodes(size_t nodes) -> void {
+      mNodes += nodes;
+    }
+
+    // NOTE: the name is only built when the span is measured, it is shown in the trace instead of the phase.
+    template <typename Describe>
+    auto name(Describe&& describe) -> void {
+      if (mActive) mName = describe();
+    }
+
+  private:
+    auto finish() -> void;
+  };
+
+  // Starts measuring, the trace events are written to `trace` unless it is null.
+  static auto start(bool statistics, std::FILE* trace) -> void;
+  // Stops measuring and completes the trace, the file is left open.
+  static auto stop() -> void;
+
+  // Prints the statistics gathered since the last report and resets them.
+  static auto report(std::FILE*) -> void;
+
+  static auto enabled() -> bool {
+    return sEnabled.load(std::memory_order_relaxed);
+  }
+
+  // Called by the replaced `operator new` of the executable, see `allocations.cc`. Allocations are
+  // only counted where it is linked in.
+  static auto countAllocation() -> void {
+    if (enabled()) tAllocations++;
+  }
+
+  static constexpr auto phaseToString(Phase phase) -> std::string_view {
+    switch (phase) {
+      case Phase::Sentence: return "sentence";
+      case Phase::Scan: return "scan";
+      case Phase::Parse: return "parse";
+      case Phase::Simplify: return "simplify";
+      case Phase::Compile: return "compile";
+      case Phase::Evaluate: return "evaluate";
+      case Phase::Print: return "print";
+      case Phase::Prove: return "prove";
+    }
+    return "unknown";
+  }
+
+private:
+  // NOTE: plain statics rather than function-local ones, so a disabled span does not pay for a guard.
+  //       The flag is read by every allocation of every thread, a relaxed load is a plain load.
+  static inline std::atomic<bool> sEnabled = false;
+  static inline thread_local size_t tAllocations = 0;
+};
+
+}
@@ -1,40 +1,232 @@
 #include "logic/utils/table.h"
 #include "logic/utils/macros.h"
 #include "logic/utils/color.h"
+#include "logic/utils/output.h"
+
+#include <cstdio>
+#include <cstring>
+#include <utility>
 
 using namespace logic;
 
-auto Table::print() const -> void {
-  static auto line = Color::Gray("|");
-  for (auto j = 0; j < mMaxColumnLength; j++) {
-    if (j == 0 or j == 1) {
-      printSeparationLine();
+auto Table::print(StreamingTable::Format format) const -> void {
+  std::vector<std::string_view> header;
+  std::vector<const Value*> columns;
+  for (const auto& column : mColumns) {
+    header.push_back(column.header());
+    columns.push_back(&column.cells());
+  }
+
+  const auto table = StreamingTable(header, format, mPadding);
+  table.printHeader(mMaxColumnLength);
+  table.printRows(columns, mMaxColumnLength);
+  table.printFooter();
+}
+
+// Quotes a column name for CSV (`escape` is `"`) or JSON (`escape` is `\`). Names are built from the
+// operators of the language, so no other character needs escaping.
+static auto quoted(std::string_view name, char escape) -> std::string {
+  std::string result = "\"";
+  for (auto c : name) {
+    if (c == '"' or (c == '\\' and escape == '\\')) result += escape;
+    result += c;
+  }
+  return result + "\"";
+}
+
+StreamingTable::StreamingTable(const std::vector<std::string_view>& header, Format format, size_t padding)
+  : mFormat(format), mPadding(padding) {
+
+  const auto line = fmt::format("{}", Color::Gray("|"));
+  for (const auto& name : header) {
+    mHeader.emplace_back(name);
+    mWidths.push_back(std::max<size_t>(name.length(), 1));
+
+    switch (mFormat) {
+      case Format::Table: {
+        auto width = mWidths.back() + 2*mPadding;
+        auto left = (width - 1) / 2;
+        mRowTemplate += line;
+        mRowTemplate.append(left, ' ');
+        mCellOffsets.push_back(mRowTemplate.size());
+        mRowTemplate += 'F';
+        mRowTemplate.append(width - 1 - left, ' ');
+        break;
+      }
+      case Format::Csv:
+        if (not mRowTemplate.empty()) mRowTemplate += ',';
+        mCellOffsets.push_back(mRowTemplate.size());
+        mRowTemplate += 'F';
+        break;
+      case Format::Jsonl:
+      case Format::Bin:
+        break;
     }
+  }
 
-    for (auto i = 0; i < mColumns.size(); i++) {
-      // print the contents
-      auto formatStr = fmt::format("{{: ^{}}}", mColumns[i].getMaxWidth() + 2*mPadding);
-      auto str = fmt::vformat(formatStr, fmt::make_format_args(mColumns[i][j]));
-      fmt::print("{}{}", line, str);
+  if (header.empty()) return;
+  if (mFormat == Format::Table) {
+    mRowTemplate += line;
+  }
+  mRowTemplate += '\n';
+}
 
-      // print the bar and the endline
-      if (i == mColumns.size() - 1) {
-        fmt::println("{}", line);
+auto StreamingTable::formatToString(Format format) -> std::string_view {
+  switch (format) {
+    case Format::Table:
+      return "table";
+    case Format::Csv:
+      return "csv";
+    case Format::Jsonl:
+      return "jsonl";
+    case Format::Bin:
+      return "bin";
+  }
+  std::unreachable();
+}
+
+auto StreamingTable::formatFromString(std::string_view name) -> std::optional<Format> {
+  for (auto format : {Format::Table, Format::Csv, Format::Jsonl, Format::Bin}) {
+    if (formatToString(format) == name) return format;
+  }
+  return std::nullopt;
+}
+
+auto StreamingTable::printHeader(size_t rows) const -> void {
+  static auto line = Color::Gray("|");
+  if (mHeader.empty()) return;
+
+  switch (mFormat) {
+    case Format::Table:
+      break;
+    case Format::Csv: {
+      std::string names;
+      for (const auto& name : mHeader) {
+        if (not names.empty()) names += ',';
+        names += name.find_first_of(",\"") == std::string::npos ? name : quoted(name, '"');
+      }
+      fmt::println(Output::out(), "{}", names);
+      return;
+    }
+    case Format::Jsonl:
+      return;
+    case Format::Bin: {
+      std::string header = "LOGICBIN";
+      const auto append = [&](auto value) { header.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+      append(uint64_t(rows));
+      append(uint32_t(mHeader.size()));
+      const auto dataOffset = header.size();
+      append(uint32_t(0));
+      for (const auto& name : mHeader) {
+        append(uint32_t(name.size()));
+        header += name;
       }
+      header.append((8 - header.size() % 8) % 8, '\0');
+
+      const auto size = uint32_t(header.size());
+      std::memcpy(header.data() + dataOffset, &size, sizeof(size));
+      std::fwrite(header.data(), 1, header.size(), Output::out());
+      return;
     }
   }
+
+  printSeparationLine();
+  for (size_t i = 0; i < mHeader.size(); i++) {
+    auto formatStr = fmt::format("{{: ^{}}}", mWidths[i] + 2*mPadding);
+    fmt::print(Output::out(), "{}{}", line, fmt::vformat(formatStr, fmt::make_format_args(mHeader[i])));
+  }
+  fmt::println(Output::out(), "{}", line);
   printSeparationLine();
 }
 
-auto Table::printSeparationLine() const -> void {
-  for (auto i = 0; i < mColumns.size(); i++) {
-    auto length = mColumns[i].getMaxWidth() + 2*mPadding;
-    auto formatStr = fmt::format("+{{:-^{}}}", length);
-    auto str = fmt::vformat(formatStr, fmt::make_format_args(""));
-    fmt::print("{}", Color::Gray(str));
+auto StreamingTable::printRows(const std::vector<const Value*>& columns, size_t rows) const -> void {
+  static constexpr size_t FLUSH_ROWS = 1 << 12;
+
+  std::string buffer;
+  for (size_t row = 0; row < rows; row += FLUSH_ROWS) {
+    buffer.clear();
+    renderRows(columns, row, std::min(FLUSH_ROWS, rows - row), buffer);
+    std::fwrite(buffer.data(), 1, buffer.size(), Output::out());
+  }
+}
+
+auto StreamingTable::renderRows(const std::vector<const Value*>& columns, size_t firstRow, size_t rows, std::string& buffer) const -> void {
+  ASSERT(columns.size() == mWidths.size());
+  if (columns.empty()) return;
+
+  if (mFormat == Format::Jsonl) {
+    renderJsonRows(columns, firstRow, rows, buffer);
+    return;
+  }
+  if (mFormat == Format::Bin) {
+    renderBinaryRows(columns, firstRow, rows, buffer);
+    return;
+  }
+
+  auto offset = buffer.size();
+  buffer.resize(offset + rows * mRowTemplate.size());
+  auto* out = buffer.data() + offset;
+
+  for (size_t row = firstRow; row < firstRow + rows; row++) {
+    std::memcpy(out, mRowTemplate.data(), mRowTemplate.size());
+    for (size_t i = 0; i < columns.size(); i++) {
+      out[mCellOffsets[i]] = columns[i]->test(row) ? 'T' : 'F';
+    }
+    out += mRowTemplate.size();
+  }
+}
+
+auto StreamingTable::renderJsonRows(const std::vector<const Value*>& columns, size_t firstRow, size_t rows, std::string& buffer) const -> void {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < mHeader.size(); i++) {
+    keys.push_back((i == 0 ? "{" : ",") + quoted(mHeader[i], '\\') + ":");
+  }
+
+  for (size_t row = firstRow; row < firstRow + rows; row++) {
+    for (size_t i = 0; i < columns.size(); i++) {
+      buffer += keys[i];
+      buffer += columns[i]->test(row) ? "true" : "false";
+    }
+    buffer += "}\n";
+  }
+}
+
+auto StreamingTable::renderBinaryRows(const std::vector<const Value*>& columns, size_t firstRow, size_t rows, std::string& buffer) const -> void {
+  using Word = Value::Word;
+  ASSERT(firstRow % Value::WORD_BITS == 0);
+
+  const auto first = firstRow / Value::WORD_BITS;
+  const auto last = Value::wordsFor(firstRow + rows);
+  const auto tail = (firstRow + rows) % Value::WORD_BITS;
+
+  auto offset = buffer.size();
+  buffer.resize(offset + (last - first) * columns.size() * sizeof(Word));
+  auto* out = buffer.data() + offset;
+
+  for (auto word = first; word < last; word++) {
+    for (const auto* column : columns) {
+      auto bits = column->words[word];
+      // NOTE: only the last word of the range can be partial, the bits past the range are cleared.
+      if (word == last - 1 and tail != 0) bits &= (Word(1) << tail) - 1;
+      std::memcpy(out, &bits, sizeof(Word));
+      out += sizeof(Word);
+    }
+  }
+}
+
+auto StreamingTable::printFooter() const -> void {
+  if (mFormat == Format::Table) {
+    printSeparationLine();
+  }
+}
+
+auto StreamingTable::printSeparationLine() const -> void {
+  for (size_t i = 0; i < mWidths.size(); i++) {
+    auto formatStr = fmt::format("+{{:-^{}}}", mWidths[i] + 2*mPadding);
+    fmt::print(Output::out(), "{}", Color::Gray(fmt::vformat(formatStr, fmt::make_format_args(""))));
   }
 
-  if (mColumns.size() != 0) {
-    fmt::println("{}", Color::Gray("+"));
+  if (mWidths.size() != 0) {
+    fmt::println(Output::out(), "{}", Color::Gray("+"));
   }
 }
@@ -1,44 +1,91 @@
 #pragma once
 
+#include "logic/evaluation/value.h"
 #include "logic/utils/macros.h"
 
 #include <algorithm>
+#include <optional>
 #include <utility>
 #include <vector>
 #include <string>
+#include <string_view>
 
 namespace logic {
 
+// A column of a truth table, the cells are kept packed and only turned into text when printed.
 class Column {
 private:
-  std::vector<std::string> cells;
-  size_t maxCellWidth = 0;
+  std::string mHeader;
+  Value mCells;
 
 public:
-  constexpr Column(size_t size)  {
-    cells.reserve(size);
-  }
-  constexpr Column() { }
+  constexpr Column(std::string_view header, Value cells) : mHeader(header), mCells(std::move(cells)) {}
 
-  constexpr auto add(std::string_view cell) -> void {
-    maxCellWidth = std::max(cell.length(), maxCellWidth);
-    cells.push_back(std::string(cell));
-  }
-  constexpr auto numberOfCells() const -> size_t {
-    return cells.size();
+  constexpr auto header() const -> std::string_view {
+    return mHeader;
   }
-  constexpr auto operator[](size_t i) const -> const std::string& {
-    return cells.at(i);
+  constexpr auto cells() const -> const Value& {
+    return mCells;
   }
-  constexpr auto getMaxWidth() const -> const size_t {
-    size_t maxWidth = 0;
-    for (const auto& cell : cells) {
-      maxWidth = std::max(maxWidth, cell.size());
-    }
-    return maxWidth;
+  constexpr auto numberOfCells() const -> size_t {
+    return mCells.size;
   }
 };
 
+// Prints a table whose rows arrive in blocks, the widths are fixed by the header
+// since every cell is either "T" or "F".
+//
+// Every row has the same layout, so it is rendered once into a template with the offset of each cell
+// and rows are then a copy of the template with the cells filled in.
+//
+// Besides the boxed table, rows can be written in machine-readable formats:
+//   - `csv`: a header line with the column names, then one line of `T`/`F` cells per row.
+//   - `jsonl`: one object per row mapping each column name to a boolean.
+//   - `bin`: the packed bits of the columns, described below.
+//
+// The `bin` format starts with a header: the magic `LOGICBIN`, the number of rows as a uint64, the
+// number of columns and the offset of the data as uint32s, then every column name as a uint32 length
+// followed by its bytes. The header is zero padded to a multiple of 8 bytes. The data is a sequence
+// of little-endian uint64 words interleaved by column: word `w` of column `c` is at index
+// `w * columns + c` and holds rows `64 * w` to `64 * w + 63`, the lowest bit first. Bits past the
+// last row are zero.
+class StreamingTable {
+public:
+  enum class Format {
+    Table,
+    Csv,
+    Jsonl,
+    Bin,
+  };
+
+  static auto formatToString(Format) -> std::string_view;
+  static auto formatFromString(std::string_view) -> std::optional<Format>;
+
+private:
+  std::vector<std::string> mHeader;
+  std::vector<size_t> mWidths;
+  Format mFormat;
+  size_t mPadding;
+
+  std::string mRowTemplate;
+  std::vector<size_t> mCellOffsets;
+
+public:
+  StreamingTable(const std::vector<std::string_view>& header, Format format = Format::Table, size_t padding = 1);
+
+  // `rows` is the number of rows that will follow, only the `bin` header records it.
+  auto printHeader(size_t rows) const -> void;
+  auto printRows(const std::vector<const Value*>& columns, size_t rows) const -> void;
+  // NOTE: with the `bin` format `firstRow` must be a multiple of 64, rows are written a word at a time.
+  auto renderRows(const std::vector<const Value*>& columns, size_t firstRow, size_t rows, std::string& buffer) const -> void;
+  auto printFooter() const -> void;
+
+private:
+  auto renderJsonRows(const std::vector<const Value*>& columns, size_t firstRow, size_t rows, std::string& buffer) const -> void;
+  auto renderBinaryRows(const std::vector<const Value*>& columns, size_t firstRow, size_t rows, std::string& buffer) const -> void;
+  auto printSeparationLine() const -> void;
+};
+
 class Table {
 private:
   std::vector<Column> mColumns;
@@ -57,16 +104,14 @@ public:
   }
   constexpr auto add(Column column) -> void {
     // columns must have the same number of cells
-    if (mMaxColumnLength == 0) {
+    if (mColumns.empty()) {
       mMaxColumnLength = column.numberOfCells();
     } else {
       ASSERT(mMaxColumnLength == column.numberOfCells());
     }
-    mColumns.push_back(column);
+    mColumns.push_back(std::move(column));
   }
-  auto print() const -> void;
-private:
-  auto printSeparationLine() const -> void;
+  auto print(StreamingTable::Format format = StreamingTable::Format::Table) const -> void;
 };
 
 };
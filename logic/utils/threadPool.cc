@@ -0,0 +1,94 @@
+#include "logic/utils/threadPool.h"
+
+#include <algorithm>
+
+using namespace logic;
+
+ThreadPool::ThreadPool(size_t threads) {
+  threads = std::max<size_t>(threads, 1);
+  for (size_t i = 0; i < threads; i++) {
+    mQueues.push_back(std::make_unique<Queue>());
+  }
+  for (size_t i = 0; i < threads; i++) {
+    mThreads.emplace_back([this, i] { work(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    auto lock = std::lock_guard(mMutex);
+    mStopping = true;
+  }
+  mWorkAvailable.notify_all();
+  for (auto& thread : mThreads) {
+    thread.join();
+  }
+}
+
+auto ThreadPool::submit(Task task) -> void {
+  // NOTE: the task is counted before it is pushed, a worker could otherwise take and finish it
+  //       first and decrement the counters below zero.
+  mPending += 1;
+  {
+    auto lock = std::lock_guard(mMutex);
+    mQueued += 1;
+  }
+
+  auto& queue = *mQueues[mNextQueue++ % mQueues.size()];
+  {
+    auto lock = std::lock_guard(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  mWorkAvailable.notify_one();
+}
+
+auto ThreadPool::wait() -> void {
+  auto lock = std::unique_lock(mMutex);
+  mIdle.wait(lock, [this] { return mPending == 0; });
+}
+
+auto ThreadPool::take(size_t index) -> std::optional<Task> {
+  // NOTE: tasks are taken in the order they were submitted. Blocks of a table are submitted in row
+  //       order and printed in that order, so the oldest one is the one the printer waits on.
+  {
+    auto& own = *mQueues[index];
+    auto lock = std::lock_guard(own.mutex);
+    if (not own.tasks.empty()) {
+      auto task = std::move(own.tasks.front());
+      own.tasks.pop_front();
+      return task;
+    }
+  }
+
+  for (size_t offset = 1; offset < mQueues.size(); offset++) {
+    auto& victim = *mQueues[(index + offset) % mQueues.size()];
+    auto lock = std::lock_guard(victim.mutex);
+    if (not victim.tasks.empty()) {
+      auto task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return task;
+    }
+  }
+  return std::nullopt;
+}
+
+auto ThreadPool::work(size_t index) -> void {
+  while (true) {
+    if (auto task = take(index)) {
+      mQueued -= 1;
+      (*task)();
+
+      if (--mPending == 0) {
+        auto lock = std::lock_guard(mMutex);
+        mIdle.notify_all();
+      }
+      continue;
+    }
+
+    auto lock = std::unique_lock(mMutex);
+    mWorkAvailable.wait(lock, [this] { return mStopping or mQueued > 0; });
+    if (mStopping and mQueued == 0) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace logic {
+
+// A fixed size pool where every worker owns a queue of tasks. Workers take the oldest task of
+// their own queue and, once it is empty, steal the oldest task of the other queues.
+class ThreadPool {
+
+public:
+  using Task = std::function<void()>;
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> mQueues;
+  std::vector<std::thread> mThreads;
+
+  std::mutex mMutex;
+  std::condition_variable mWorkAvailable;
+  std::condition_variable mIdle;
+
+  std::atomic<size_t> mQueued = 0;
+  std::atomic<size_t> mPending = 0;
+  std::atomic<size_t> mNextQueue = 0;
+  bool mStopping = false;
+
+public:
+  explicit ThreadPool(size_t threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+  auto submit(Task) -> void;
+
+  // Blocks until every task submitted so far has finished.
+  auto wait() -> void;
+
+  constexpr auto size() const -> size_t {
+    return mThreads.size();
+  }
+
+private:
+  auto work(size_t index) -> void;
+  auto take(size_t index) -> std::optional<Task>;
+};
+
+}
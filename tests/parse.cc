@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+
+#include "parse.h"
+#include "reporter.h"
+#include "logic/parsing/parser.h"
+#include "logic/parsing/scanner.h"
+
+auto logic::parse(std::string_view source) -> Sentence {
+  const auto failed = [] {
+    return Sentence::Value(Token(TokenType::False, SourceLocation(0, 0, 0, "TEST"), "FALSE"));
+  };
+
+  auto tokens = Scanner(source).scan();
+  if (not tokens.has_value()) {
+    ADD_FAILURE() << report(tokens.error()) << " in " << source;
+    return failed();
+  }
+  auto sentences = Parser(std::move(*tokens)).parse();
+  if (not sentences.has_value()) {
+    ADD_FAILURE() << report(sentences.error()) << " in " << source;
+    return failed();
+  }
+  if (sentences->empty()) {
+    ADD_FAILURE() << "No sentence in " << source;
+    return failed();
+  }
+  return std::move(sentences->front());
+}
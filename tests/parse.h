@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "logic/parsing/sentence.h"
+
+namespace logic {
+
+// Scans and parses the first sentence of the source, failing the current test with the error if
+// there is one. A failed parse gives `FALSE`, so that the test can go on.
+auto parse(std::string_view source) -> Sentence;
+
+// Far deeper than the call stack would allow any recursive pass over a sentence to go.
+inline constexpr size_t NESTING_DEPTH = 200000;
+
+}
@@ -11,7 +11,11 @@ auto logic::operator<<(std::ostream& stream, const Sentence& sentence) -> std::o
 }
 
 auto logic::operator<<(std::ostream& stream, const Value& value) -> std::ostream& {
-  return stream << fmt::format("Value({})", fmt::join(value.data, ", "));
+  auto bits = std::vector<bool>(value.size);
+  for (size_t i = 0; i < value.size; i++) {
+    bits[i] = value.test(i);
+  }
+  return stream << fmt::format("Value({})", fmt::join(bits, ", "));
 }
 
 auto logic::operator<<(std::ostream& stream, const TokenType& value) -> std::ostream& {
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "logic/bdd/bdd.h"
+#include "logic/evaluation/evaluator.h"
+#include "logic/evaluation/nodeTable.h"
+#include "logic/solver/prover.h"
+#include "logic/utils/bigInt.h"
+
+#include "tests/parse.h"
+
+using namespace logic;
+
+// Lowers the sentence the way queries are, with no variable assigned.
+static auto lower(const Sentence& sentence, NodeTable& nodes) -> NodeId {
+  const auto environment = Environment();
+  auto root = Prover(environment).lower(sentence, nodes);
+  EXPECT_TRUE(root.has_value());
+  return *root;
+}
+
+// (X0 AND Y0) OR (X1 AND Y1) OR ... whose diagram is exponential when every X comes before every Y.
+static auto interleaved(Bdd& bdd, uint32_t pairs) -> Bdd::Edge {
+  auto function = Bdd::ZERO;
+  bdd.ref(function);
+  for (uint32_t i = 0; i < pairs; i++) {
+    auto next = bdd.disjunction(function, bdd.conjunction(bdd.variable(i), bdd.variable(pairs + i)));
+    bdd.ref(next);
+    bdd.deref(function);
+    function = next;
+  }
+  return function;
+}
+
+TEST(Bdd, TestEquivalentSentencesShareAnEdge) {
+  auto nodes = NodeTable();
+  auto a = lower(parse("NOT (P AND Q) OR R"), nodes);
+  auto b = lower(parse("(P IMPLIES NOT Q) OR R"), nodes);
+  auto c = lower(parse("NOT P OR (NOT Q OR R)"), nodes);
+  auto d = lower(parse("P AND Q AND NOT R"), nodes);
+
+  auto bdd = Bdd(nodes.variables().size());
+  auto fa = bdd.build(nodes, a);
+  auto fb = bdd.build(nodes, b);
+  auto fc = bdd.build(nodes, c);
+  auto fd = bdd.build(nodes, d);
+
+  EXPECT_EQ(fa, fb);
+  EXPECT_EQ(fa, fc);
+  EXPECT_EQ(fd, Bdd::negation(fa));
+  EXPECT_EQ(bdd.build(nodes, lower(parse("P OR NOT P"), nodes)), Bdd::ONE);
+}
+
+TEST(Bdd, TestCountMatchesTruthTable) {
+  const auto sources = {
+    "(A IMPLIES B) EQUIVALENT NOT (C OR D AND E)",
+    "A AND NOT A",
+    "(A OR B) AND (C IMPLIES D) AND (E EQUIVALENT NOT F) AND G",
+    "NOT (A EQUIVALENT (B EQUIVALENT (C EQUIVALENT D)))",
+  };
+
+  for (auto source : sources) {
+    auto sentence = parse(source);
+    auto environment = Environment();
+    auto expected = Evaluator(environment).evaluate(sentence);
+
+    auto nodes = NodeTable();
+    auto root = lower(sentence, nodes);
+    auto bdd = Bdd(nodes.variables().size());
+    auto function = bdd.build(nodes, root);
+
+    EXPECT_EQ(bdd.count(function), BigInt(expected->count())) << source;
+  }
+}
+
+TEST(Bdd, TestCountBeyondSixtyFourVariables) {
+  auto bdd = Bdd(200);
+  // X0 OR X1: three quarters of all 2^200 assignments.
+  auto function = bdd.disjunction(bdd.variable(0), bdd.variable(1));
+  EXPECT_EQ(bdd.count(function), BigInt::powerOfTwo(198) * BigInt(3));
+  EXPECT_EQ(bdd.count(Bdd::negation(function)), BigInt::powerOfTwo(198));
+}
+
+TEST(Bdd, TestSiftingPreservesFunctionsAndShrinks) {
+  constexpr uint32_t pairs = 8;
+  auto bdd = Bdd(2 * pairs);
+  bdd.setAutoReorder(false);
+
+  auto function = interleaved(bdd, pairs);
+  bdd.collect();
+  const auto before = bdd.size(function);
+  const auto count = bdd.count(function);
+
+  auto generator = std::mt19937(3);
+  std::vector<std::vector<bool>> assignments;
+  std::vector<bool> expected;
+  for (int i = 0; i < 200; i++) {
+    auto assignment = std::vector<bool>(2 * pairs);
+    for (size_t k = 0; k < assignment.size(); k++) assignment[k] = generator() % 2;
+    expected.push_back(bdd.evaluate(function, assignment));
+    assignments.push_back(std::move(assignment));
+  }
+
+  bdd.reorder();
+
+  EXPECT_LT(bdd.size(function), before);
+  EXPECT_EQ(bdd.size(function), bdd.size());
+  EXPECT_EQ(bdd.count(function), count);
+  for (size_t i = 0; i < assignments.size(); i++) {
+    EXPECT_EQ(bdd.evaluate(function, assignments[i]), expected[i]);
+  }
+}
+
+TEST(Bdd, TestGarbageCollection) {
+  auto bdd = Bdd(8);
+  auto function = interleaved(bdd, 4);
+  EXPECT_GT(bdd.size(), 1);
+
+  bdd.deref(function);
+  bdd.collect();
+  EXPECT_EQ(bdd.size(), 1);
+
+  // freed nodes are reused and the results are still canonical.
+  auto again = interleaved(bdd, 4);
+  bdd.collect();
+  EXPECT_EQ(bdd.size(again), bdd.size());
+}
+
+TEST(Bdd, TestSatisfy) {
+  auto nodes = NodeTable();
+  auto root = lower(parse("(P OR Q) AND NOT P AND (R EQUIVALENT Q)"), nodes);
+  auto bdd = Bdd(nodes.variables().size());
+  auto function = bdd.build(nodes, root);
+
+  EXPECT_TRUE(bdd.evaluate(function, bdd.satisfy(function)));
+}
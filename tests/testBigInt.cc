@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+
+#include "logic/utils/bigInt.h"
+
+using namespace logic;
+
+TEST(BigInt, TestToString) {
+  EXPECT_EQ(BigInt().toString(), "0");
+  EXPECT_EQ(BigInt(42).toString(), "42");
+  EXPECT_EQ(BigInt(1'000'000'000).toString(), "1000000000");
+  EXPECT_EQ(BigInt(UINT64_MAX).toString(), "18446744073709551615");
+  EXPECT_EQ(BigInt::powerOfTwo(100).toString(), "1267650600228229401496703205376");
+}
+
+TEST(BigInt, TestArithmetic) {
+  const auto big = BigInt::powerOfTwo(128);
+  EXPECT_EQ((big - BigInt(1) + BigInt(1)), big);
+  EXPECT_EQ((big - BigInt(1)).toString(), "340282366920938463463374607431768211455");
+  EXPECT_EQ(BigInt(UINT64_MAX) * BigInt(UINT64_MAX), BigInt::powerOfTwo(128) - BigInt::powerOfTwo(65) + BigInt(1));
+  EXPECT_EQ(BigInt(3) << 70, BigInt::powerOfTwo(70) + BigInt::powerOfTwo(71));
+  EXPECT_EQ(big - big, BigInt());
+  EXPECT_LT(BigInt(5), big);
+  EXPECT_GT(big, BigInt::powerOfTwo(127));
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include "logic/evaluation/columnCache.h"
+#include "logic/evaluation/evaluator.h"
+#include "logic/evaluation/program.h"
+
+#include "tests/parse.h"
+#include "tests/printer.h"
+#include "tests/reporter.h"
+
+using namespace logic;
+
+// a sub-sentence with enough connectives to be looked up in the cache.
+static constexpr auto ANTECEDENT =
+  "((A AND B) OR (C AND D) OR (E AND F) OR (A IMPLIES NOT B) OR (C EQUIVALENT D) OR (E AND NOT F)"
+  " OR (NOT A AND C) OR (B OR NOT D) OR (F IMPLIES E))";
+
+static auto run(std::string_view source, Environment& environment, ColumnCache& cache, size_t blockRows) -> Value {
+  auto sentence = parse(source);
+  auto program = Evaluator(environment, nullptr, StreamingTable::Format::Table, &cache).compile(sentence, false);
+  EXPECT_TRUE(program.has_value());
+
+  auto machine = Machine();
+  auto result = Value(false, environment.totalRows());
+  for (size_t start = 0; start < environment.totalRows(); start += blockRows) {
+    const auto rows = std::min(blockRows, environment.totalRows() - start);
+    machine.run(*program, environment, RowRange(start, rows), &cache);
+    for (size_t row = 0; row < rows; row++) {
+      result.set(start + row, machine.at(program->result).test(row));
+    }
+  }
+  return result;
+}
+
+TEST(ColumnCache, TestLeastRecentlyUsedEviction) {
+  const auto column = Value(true, 64);
+  const auto entry = size_t(1024);
+  auto cache = ColumnCache(3 * entry);
+
+  auto first = Fingerprint::leaf(Node::Kind::Variable, 0);
+  auto second = Fingerprint::leaf(Node::Kind::Variable, 1);
+
+  auto into = Value();
+  cache.insert(first, RowRange(0, 64), column);
+  cache.insert(second, RowRange(0, 64), column);
+  EXPECT_TRUE(cache.lookup(first, RowRange(0, 64), into));
+  EXPECT_EQ(into, column);
+  EXPECT_FALSE(cache.lookup(first, RowRange(64, 64), into));
+
+  // the entries are small, so fill the cache until something has to go.
+  for (uint64_t i = 3; cache.statistics().evictions == 0; i++) {
+    cache.insert(Fingerprint::leaf(Node::Kind::Variable, i), RowRange(0, 64), column);
+    EXPECT_TRUE(cache.lookup(first, RowRange(0, 64), into));
+  }
+  EXPECT_FALSE(cache.lookup(second, RowRange(0, 64), into));
+  EXPECT_TRUE(cache.lookup(first, RowRange(0, 64), into));
+  EXPECT_LE(cache.bytes(), 3 * entry);
+}
+
+TEST(ColumnCache, TestFingerprintsAreCanonical) {
+  auto a = Fingerprint::leaf(Node::Kind::Variable, 0);
+  auto b = Fingerprint::leaf(Node::Kind::Variable, 1);
+
+  EXPECT_EQ(Fingerprint::node(Node::Kind::Conjunction, a, b), Fingerprint::node(Node::Kind::Conjunction, b, a));
+  EXPECT_NE(Fingerprint::node(Node::Kind::Implication, a, b), Fingerprint::node(Node::Kind::Implication, b, a));
+  EXPECT_NE(Fingerprint::node(Node::Kind::Conjunction, a, b), Fingerprint::node(Node::Kind::Disjunction, a, b));
+  EXPECT_NE(Fingerprint::leaf(Node::Kind::Variable, 1), Fingerprint::leaf(Node::Kind::Constant, 1));
+}
+
+TEST(ColumnCache, TestSharedSubSentencesAreReused) {
+  auto environment = Environment();
+  auto cache = ColumnCache();
+  auto uncached = ColumnCache(0);
+
+  const auto first = std::string(ANTECEDENT) + " IMPLIES G";
+  const auto second = std::string(ANTECEDENT) + " AND NOT G";
+
+  auto program = Evaluator(environment, nullptr, StreamingTable::Format::Table, &cache).compile(parse(first), false);
+  ASSERT_TRUE(program.has_value());
+  EXPECT_FALSE(program->guards.empty());
+
+  for (auto blockRows : {size_t(128), size_t(24)}) {
+    cache.clear();
+    const auto expected = run(first, environment, uncached, blockRows);
+    EXPECT_EQ(run(first, environment, cache, blockRows), expected);
+
+    const auto hits = cache.statistics().hits;
+    EXPECT_EQ(run(second, environment, cache, blockRows), run(second, environment, uncached, blockRows));
+    EXPECT_GT(cache.statistics().hits, hits);
+  }
+}
+
+TEST(ColumnCache, TestVariableOrderIsPartOfTheKey) {
+  auto cache = ColumnCache();
+
+  // another variable that sorts last moves the variables of the sentence to higher bits of the row index.
+  auto environment = Environment();
+  const auto narrow = run(ANTECEDENT, environment, cache, 64);
+
+  auto wider = Environment();
+  const auto misses = cache.statistics().misses;
+  const auto wide = run(std::string(ANTECEDENT) + " OR (Z AND NOT Z)", wider, cache, 64);
+  EXPECT_GT(cache.statistics().misses, misses);
+
+  for (size_t row = 0; row < narrow.size; row++) {
+    EXPECT_EQ(wide.test(2 * row), narrow.test(row)) << row;
+  }
+}
+
+TEST(ColumnCache, TestTruthTablesAreServed) {
+  // every sub-sentence of a truth table is a column of its own, they are restored along with the antecedent.
+  const auto table = [](std::string_view source, Environment& environment, ColumnCache& cache) {
+    auto program = Evaluator(environment, nullptr, StreamingTable::Format::Table, &cache).compile(parse(source));
+    EXPECT_TRUE(program.has_value());
+
+    auto machine = Machine();
+    auto columns = std::vector<std::pair<std::string, Value>>();
+    for (const auto& output : program->outputs) columns.emplace_back(output.name, Value(false, environment.totalRows()));
+    for (size_t start = 0; start < environment.totalRows(); start += 16) {
+      machine.run(*program, environment, RowRange(start, 16), &cache);
+      for (size_t i = 0; i < columns.size(); i++) {
+        for (size_t row = 0; row < 16; row++) columns[i].second.set(start + row, machine.at(program->outputs[i].reg).test(row));
+      }
+    }
+    return columns;
+  };
+
+  auto environment = Environment();
+  auto cache = ColumnCache();
+  auto uncached = ColumnCache(0);
+
+  const auto first = std::string(ANTECEDENT) + " IMPLIES G";
+  const auto second = "(C OR G) AND " + std::string(ANTECEDENT);
+  EXPECT_EQ(table(first, environment, cache), table(first, environment, uncached));
+
+  const auto hits = cache.statistics().hits;
+  EXPECT_EQ(table(second, environment, cache), table(second, environment, uncached));
+  EXPECT_GT(cache.statistics().hits, hits);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <fmt/core.h>
+
+#include "logic/evaluation/evaluator.h"
+#include "logic/solver/cnf.h"
+#include "logic/solver/counter.h"
+#include "logic/solver/prover.h"
+#include "logic/utils/bigInt.h"
+
+#include "tests/parse.h"
+
+using namespace logic;
+
+static auto count(const std::string& source, Prover::Backend backend) -> BigInt {
+  auto sentence = parse(source);
+  auto environment = Environment();
+  auto answer = Prover(environment, backend).prove(sentence.unsafeAsRef<Sentence::Query>());
+  return answer->count;
+}
+
+TEST(Counter, TestCountMatchesTruthTable) {
+  const auto sources = {
+    "(A IMPLIES B) EQUIVALENT NOT (C OR D AND E)",
+    "A AND NOT A",
+    "A OR NOT A",
+    "(A OR B) AND (C IMPLIES D) AND (E EQUIVALENT NOT F) AND G",
+    "NOT (A EQUIVALENT (B EQUIVALENT (C EQUIVALENT D)))",
+    "(A AND TRUE) OR (B AND FALSE) OR (C AND D)",
+  };
+
+  for (std::string source : sources) {
+    auto environment = Environment();
+    auto expected = Evaluator(environment).evaluate(parse(source));
+
+    EXPECT_EQ(count("COUNT " + source, Prover::Backend::Sat), BigInt(expected->count())) << source;
+    EXPECT_EQ(count("COUNT " + source, Prover::Backend::Bdd), BigInt(expected->count())) << source;
+  }
+}
+
+TEST(Counter, TestIndependentComponentsMultiply) {
+  // (A0 OR B0) AND ... AND (A99 OR B99): 100 independent components of 3 models each.
+  std::string source;
+  auto expected = BigInt(1);
+  for (int i = 0; i < 100; i++) {
+    if (not source.empty()) source += " AND ";
+    source += fmt::format("(A{} OR B{})", i, i);
+    expected *= BigInt(3);
+  }
+
+  EXPECT_EQ(count("COUNT " + source, Prover::Backend::Sat), expected);
+  EXPECT_EQ(count("COUNT " + source, Prover::Backend::Bdd), expected);
+}
+
+TEST(Counter, TestHundredsOfVariables) {
+  // X0 => X1 => ... => X299: a model is a point where the chain switches from false to true.
+  std::string chain;
+  for (int i = 0; i < 299; i++) {
+    if (not chain.empty()) chain += " AND ";
+    chain += fmt::format("(X{} IMPLIES X{})", i, i + 1);
+  }
+  EXPECT_EQ(count("COUNT " + chain, Prover::Backend::Sat), BigInt(301));
+
+  // the unconstrained Y doubles the count.
+  EXPECT_EQ(count(fmt::format("COUNT ({}) AND (Y OR NOT Y)", chain), Prover::Backend::Sat), BigInt(602));
+}
+
+TEST(Counter, TestCnf) {
+  auto cnf = Cnf();
+  const auto a = cnf.newVariable();
+  const auto b = cnf.newVariable();
+  cnf.newVariable();
+  cnf.addClause({Literal::positive(a), Literal::positive(b)});
+  // 3 assignments of A and B, times 2 for the variable in no clause.
+  EXPECT_EQ(Counter(cnf).count(), BigInt(6));
+
+  cnf.addClause({Literal::negative(a)});
+  cnf.addClause({Literal::negative(b)});
+  EXPECT_EQ(Counter(cnf).count(), BigInt());
+}
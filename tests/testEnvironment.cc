@@ -43,3 +43,76 @@ TEST(Environment, TestVariableAssignment) {
   EXPECT_EQ(env.read("A"), std::vector<bool>(length, true));
   EXPECT_EQ(env.read("B"), std::vector<bool>(length, false));
 }
+
+TEST(Environment, TestBlockRead) {
+  auto env = Environment();
+
+  for (auto v : {"P", "Q", "S"}) {
+    env.define(v);
+  }
+
+  EXPECT_EQ(env.read("P", 2, 4), std::vector<bool>({true, true, false, false}));
+  EXPECT_EQ(env.read("Q", 2, 4), std::vector<bool>({false, false, true, true}));
+  EXPECT_EQ(env.read("S", 3, 3), std::vector<bool>({false, true, false}));
+}
+
+TEST(Environment, TestMoreThanSixteenVariables) {
+  auto env = Environment();
+  auto names = std::vector<std::string>();
+  for (auto c = 'A'; c < 'A' + Environment::MAX_VARIABLES; c++) {
+    names.emplace_back(1, c);
+  }
+
+  for (const auto& name : names) {
+    EXPECT_TRUE(env.define(name));
+  }
+  EXPECT_FALSE(env.define("z"));
+  EXPECT_EQ(env.totalRows(), size_t(1) << Environment::MAX_VARIABLES);
+
+  // the slowest changing variable flips exactly halfway through the table
+  auto half = env.totalRows() / 2;
+  EXPECT_EQ(env.read("A", half - 2, 4), std::vector<bool>({true, true, false, false}));
+  EXPECT_EQ(env.read(names.back(), half - 2, 4), std::vector<bool>({true, false, true, false}));
+}
+
+TEST(Environment, TestSlotReadMatchesRows) {
+  auto env = Environment();
+  for (auto v : {"H", "G", "F", "E", "D", "C", "B", "A"}) {
+    env.define(v);
+  }
+  env.assign("Z", true);
+
+  for (auto name : {"A", "B", "C", "D", "E", "F", "G", "H"}) {
+    auto slot = env.slotOf(name);
+    ASSERT_TRUE(slot.has_value());
+    EXPECT_EQ(env.definedVariables()[*slot], name);
+
+    const auto offset = env.totalVariablesDefined() - 1 - *slot;
+    for (auto range : {RowRange(0, 256), RowRange(64, 100), RowRange(128, 1), RowRange(3, 70)}) {
+      auto column = Value();
+      env.read(*slot, range, column);
+
+      auto expected = std::vector<bool>();
+      for (size_t row = range.start; row < range.start + range.rows; row++) {
+        expected.push_back(not ((row >> offset) & 1));
+      }
+      EXPECT_EQ(column, Value(expected)) << name << " from row " << range.start;
+    }
+  }
+  EXPECT_FALSE(env.slotOf("Z").has_value());
+}
+
+TEST(Environment, TestColumnWordsAtAnyOffset) {
+  static_assert(Environment::columnWord(0, 0) == 0x5555555555555555);
+  static_assert(Environment::columnWord(6, 64) == 0);
+
+  for (uint32_t offset = 0; offset < 10; offset++) {
+    for (size_t firstRow : {0, 1, 5, 63, 64, 100, 127, 500, 1000, 1023}) {
+      auto expected = Value::Word(0);
+      for (size_t bit = 0; bit < Value::WORD_BITS; bit++) {
+        expected |= Value::Word(not (((firstRow + bit) >> offset) & 1)) << bit;
+      }
+      EXPECT_EQ(Environment::columnWord(offset, firstRow), expected) << "offset " << offset << " from row " << firstRow;
+    }
+  }
+}
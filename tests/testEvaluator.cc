@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <iostream>
+#include <optional>
 
 #include <gtest/gtest.h>
 
@@ -8,6 +10,7 @@
 #include "logic/parsing/parser.h"
 #include "logic/utils/macros.h"
 #include "logic/utils/overloaded.h"
+#include "tests/parse.h"
 #include "tests/reporter.h"
 
 using namespace logic;
@@ -93,3 +96,63 @@ TEST(Evaluator, TestMultipleVariables) {
   verifyResult("(P IMPLIES Q) IMPLIES S", {true, false, true, true, true, false, true ,false});
 }
 
+
+TEST(Evaluator, TestMultipleWords) {
+  auto conjunction = std::vector<bool>(128, false);
+  conjunction[0] = true;
+  verifyResult("A AND B AND C AND D AND E AND F AND G", conjunction);
+
+  auto negation = std::vector<bool>(128, true);
+  negation[0] = false;
+  verifyResult("NOT (A AND B AND C AND D AND E AND F AND G)", negation);
+
+  verifyResult("A OR NOT A OR B OR C OR D OR E OR F OR G", Value(true, 128));
+  verifyResult("(A AND B AND C AND D AND E AND F AND G) EQUIVALENT FALSE", negation);
+}
+
+TEST(Evaluator, TestClassify) {
+  const auto classify = [](std::string_view source, Environment& environment) -> std::optional<Classification> {
+    auto classification = Evaluator(environment).classify(parse(source));
+    EXPECT_TRUE(classification.has_value());
+    return classification ? std::optional(std::move(*classification)) : std::nullopt;
+  };
+
+  auto environment = Environment();
+  EXPECT_EQ(classify("P OR NOT P", environment)->kind, Classification::Kind::Tautology);
+  EXPECT_EQ(classify("(P IMPLIES Q) EQUIVALENT (NOT Q IMPLIES NOT P)", environment)->kind, Classification::Kind::Tautology);
+  EXPECT_EQ(classify("P AND NOT P", environment)->kind, Classification::Kind::Contradiction);
+  EXPECT_TRUE(classify("TRUE", environment)->counterexample.empty());
+
+  // the first row has every variable true, and the counterexample is found in the first block.
+  auto contingent = classify("A AND B IMPLIES C", environment);
+  EXPECT_EQ(contingent->kind, Classification::Kind::Contingent);
+  using Witness = std::vector<std::pair<std::string_view, bool>>;
+  EXPECT_EQ(contingent->model, (Witness {{"A", true}, {"B", true}, {"C", true}}));
+  EXPECT_EQ(contingent->counterexample, (Witness {{"A", true}, {"B", true}, {"C", false}}));
+
+  // 20 variables take many blocks, the only model is the last row.
+  auto last = classify("NOT (A OR B OR C OR D OR E OR F OR G OR H OR I OR J OR K OR L OR M OR N OR O OR P OR Q OR R OR S OR T)", environment);
+  EXPECT_EQ(last->kind, Classification::Kind::Contingent);
+  EXPECT_TRUE(std::ranges::all_of(last->model, [](const auto& assignment) { return not assignment.second; }));
+  EXPECT_TRUE(std::ranges::all_of(last->counterexample, [](const auto& assignment) { return assignment.second; }));
+
+  EXPECT_EQ(Value({false, false, true}).find(true), 2);
+  EXPECT_EQ(Value(true, 70).find(false), 70);
+  EXPECT_EQ(Value(false, 70).find(false), 0);
+}
+
+TEST(Evaluator, TestDeeplyNestedSentences) {
+  // `P IMPLIES (NOT NOT P IMPLIES (... NOT NOT Q))` is `P IMPLIES Q`, however deep it is nested.
+  auto source = std::string();
+  for (size_t i = 0; i < NESTING_DEPTH; i++) source += i % 2 == 0 ? "P IMPLIES (" : "NOT NOT ";
+  source += "Q";
+  source += std::string(NESTING_DEPTH / 2, ')');
+  const auto sentence = parse(source);
+
+  auto environment = Environment();
+  auto program = Evaluator(environment).compile(sentence, false);
+  ASSERT_TRUE(program.has_value());
+  auto machine = Machine();
+  machine.run(*program, environment, RowRange(0, environment.totalRows()));
+  EXPECT_EQ(machine.at(program->result), Value({true, false, true, true}));
+}
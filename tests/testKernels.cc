@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <random>
+#include <vector>
+
+#include "logic/evaluation/kernels.h"
+#include "logic/evaluation/evaluator.h"
+
+#include "tests/parse.h"
+
+using namespace logic;
+
+using Word = Kernels::Word;
+
+static constexpr auto LEVELS = {Kernels::Level::Scalar, Kernels::Level::AVX2, Kernels::Level::AVX512};
+
+static auto randomWords(size_t size, std::mt19937_64& generator) -> std::vector<Word> {
+  auto words = std::vector<Word>(size);
+  for (auto& word : words) {
+    word = generator();
+  }
+  return words;
+}
+
+// NOTE: the sizes cover empty inputs, the vector tails and several full vector iterations.
+static constexpr auto SIZES = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33, 100};
+
+TEST(Kernels, TestConnectives) {
+  auto generator = std::mt19937_64(42);
+  const auto initial = Kernels::level();
+
+  for (auto level : LEVELS) {
+    if (not Kernels::force(level)) { continue; }
+
+    for (size_t size : SIZES) {
+      const auto p = randomWords(size, generator);
+      const auto q = randomWords(size, generator);
+      auto out = std::vector<Word>(size);
+
+      Kernels::negation(out.data(), p.data(), size);
+      for (size_t i = 0; i < size; i++) EXPECT_EQ(out[i], ~p[i]) << Kernels::levelToString(level);
+
+      Kernels::conjunction(out.data(), p.data(), q.data(), size);
+      for (size_t i = 0; i < size; i++) EXPECT_EQ(out[i], p[i] & q[i]) << Kernels::levelToString(level);
+
+      Kernels::disjunction(out.data(), p.data(), q.data(), size);
+      for (size_t i = 0; i < size; i++) EXPECT_EQ(out[i], p[i] | q[i]) << Kernels::levelToString(level);
+
+      Kernels::implication(out.data(), p.data(), q.data(), size);
+      for (size_t i = 0; i < size; i++) EXPECT_EQ(out[i], ~p[i] | q[i]) << Kernels::levelToString(level);
+
+      Kernels::bijection(out.data(), p.data(), q.data(), size);
+      for (size_t i = 0; i < size; i++) EXPECT_EQ(out[i], ~(p[i] ^ q[i])) << Kernels::levelToString(level);
+    }
+  }
+
+  Kernels::force(initial);
+}
+
+TEST(Kernels, TestPopcount) {
+  auto generator = std::mt19937_64(7);
+  const auto initial = Kernels::level();
+
+  for (auto level : LEVELS) {
+    if (not Kernels::force(level)) { continue; }
+
+    for (size_t size : SIZES) {
+      const auto words = randomWords(size, generator);
+      size_t expected = 0;
+      for (auto word : words) expected += std::popcount(word);
+
+      EXPECT_EQ(Kernels::popcount(words.data(), size), expected) << Kernels::levelToString(level);
+    }
+  }
+
+  Kernels::force(initial);
+}
+
+TEST(Kernels, TestEvaluationIsIndependentOfLevel) {
+  const auto initial = Kernels::level();
+  const auto source = "(A IMPLIES B) EQUIVALENT NOT (C OR D AND E) AND (F OR NOT G) AND H";
+
+  auto evaluate = [&]() -> Value {
+    auto environment = Environment();
+    auto evaluator = Evaluator(environment);
+    return *evaluator.evaluate(parse(source));
+  };
+
+  Kernels::force(Kernels::Level::Scalar);
+  const auto expected = evaluate();
+
+  for (auto level : LEVELS) {
+    if (not Kernels::force(level)) { continue; }
+    EXPECT_EQ(evaluate(), expected) << Kernels::levelToString(level);
+  }
+
+  Kernels::force(initial);
+}
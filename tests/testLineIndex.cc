@@ -0,0 +1,19 @@
+#include <gtest/gtest.h>
+
+#include "logic/utils/lineIndex.h"
+
+using namespace logic;
+
+TEST(LineIndex, TestLines) {
+  const auto lines = LineIndex("P AND Q\n\nSAT P\r\nQ");
+  EXPECT_EQ(lines.line(1), "P AND Q");
+  EXPECT_EQ(lines.line(2), "");
+  EXPECT_EQ(lines.line(3), "SAT P\r");
+  EXPECT_EQ(lines.line(4), "Q");
+
+  // lines past the end of the source are empty.
+  EXPECT_EQ(lines.line(0), "");
+  EXPECT_EQ(lines.line(5), "");
+  EXPECT_EQ(LineIndex("P\n").line(2), "");
+  EXPECT_EQ(LineIndex("").line(1), "");
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include <stdlib.h>
+
+#include "logic/logic.h"
+#include "logic/utils/output.h"
+
+using namespace logic;
+
+// Runs a source file through the command line driver and returns what it printed to the standard output,
+// what it printed to the standard error is kept in `errors` when it is given.
+static auto run(std::string_view source, Options options, std::string* errors = nullptr) -> std::string {
+  auto path = std::string("/tmp/logic-source-XXXXXX");
+  auto* file = fdopen(mkstemp(path.data()), "w");
+  std::fwrite(source.data(), 1, source.size(), file);
+  std::fclose(file);
+
+  char* buffer = nullptr;
+  char* diagnostics = nullptr;
+  size_t size = 0, diagnosticsSize = 0;
+  auto* out = open_memstream(&buffer, &size);
+  auto* err = open_memstream(&diagnostics, &diagnosticsSize);
+  {
+    auto redirect = Output::Redirect(out, err);
+    Logic(options).runFile(path);
+  }
+  std::fclose(out);
+  std::fclose(err);
+  std::remove(path.c_str());
+
+  auto text = std::string(buffer, size);
+  if (errors != nullptr) *errors = std::string(diagnostics, diagnosticsSize);
+  std::free(buffer);
+  std::free(diagnostics);
+  return text;
+}
+
+TEST(Logic, TestClassifyAppliesAssignments) {
+  auto options = Options();
+  options.classify = true;
+
+  // the assignment is applied without being classified, `P` is then true on every row.
+  const auto text = run("P = TRUE\nP OR Q\nP AND Q\n", options);
+  EXPECT_EQ(text.find("P = TRUE"), std::string::npos);
+  EXPECT_NE(text.find("TAUTOLOGY"), std::string::npos);
+  EXPECT_NE(text.find("CONTINGENT"), std::string::npos);
+  EXPECT_EQ(text.find("TAUTOLOGY"), text.rfind("TAUTOLOGY"));
+}
+
+TEST(Logic, TestBatchAppliesAssignmentsAcrossShards) {
+  // NOTE: the source spans several shards, with assignments spread all over it.
+  auto source = std::string();
+  for (size_t i = 0; i < 6000; i++) {
+    if (i % 1000 == 500) source += i % 2000 == 500 ? "P = TRUE\n" : "P = FALSE\n";
+    source += i % 3 == 0 ? "P AND (Q OR R)\n" : "SAT P AND NOT Q\n";
+  }
+
+  auto sequential = Options();
+  sequential.format = StreamingTable::Format::Csv;
+  auto batch = sequential;
+  batch.jobs = 4;
+  batch.batch = true;
+  EXPECT_EQ(run(source, batch), run(source, sequential));
+}
+
+TEST(Logic, TestBatchReportsSyntaxErrorsOfEveryShard) {
+  // NOTE: the errors are in different shards, far apart from each other and from the start.
+  auto source = std::string();
+  for (size_t i = 0; i < 40000; i++) {
+    source += "P AND Q\n";
+    if (i == 30000) source += "P AND )\n";
+    if (i == 35000) source += "Q OR )\n";
+  }
+
+  auto sequential = Options();
+  sequential.format = StreamingTable::Format::Csv;
+  auto batch = sequential;
+  batch.jobs = 4;
+  batch.batch = true;
+
+  auto sequentialErrors = std::string();
+  auto batchErrors = std::string();
+  const auto sequentialText = run(source, sequential, &sequentialErrors);
+  const auto batchText = run(source, batch, &batchErrors);
+
+  EXPECT_EQ(batchText, sequentialText);
+  EXPECT_EQ(batchText, "");
+  EXPECT_EQ(batchErrors, sequentialErrors);
+  EXPECT_NE(batchErrors.find("30002"), std::string::npos);
+  EXPECT_NE(batchErrors.find("35003"), std::string::npos);
+}
+
+TEST(Logic, TestSimplifiedLeavesKeepTheirResultColumn) {
+  auto options = Options();
+  options.format = StreamingTable::Format::Csv;
+  options.simplify = true;
+
+  // NOTE: every sentence simplifies to a leaf, which has no column of its own.
+  const auto text = run("D EQUIVALENT D\nA OR D AND A\nX AND FALSE\n", options);
+  EXPECT_NE(text.find("D,D <=> D\nT,T\nF,T\n"), std::string::npos);
+  EXPECT_NE(text.find("A,D,A ∨ (D ∧ A)\nT,T,T\nT,F,T\nF,T,F\nF,F,F\n"), std::string::npos);
+  EXPECT_NE(text.find("X,X ∧ FALSE\nT,F\nF,F\n"), std::string::npos);
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include <stdlib.h>
+
+#include "logic/utils/mappedFile.h"
+
+using namespace logic;
+
+static auto writeTemporary(std::string_view contents) -> std::string {
+  auto path = std::string("/tmp/logic-mapped-XXXXXX");
+  auto* file = fdopen(mkstemp(path.data()), "w");
+  std::fwrite(contents.data(), 1, contents.size(), file);
+  std::fclose(file);
+  return path;
+}
+
+TEST(MappedFile, TestContents) {
+  const auto path = writeTemporary("P AND Q\nSAT P");
+  auto file = MappedFile::open(path);
+  ASSERT_TRUE(file.has_value());
+  EXPECT_EQ(file->contents(), "P AND Q\nSAT P");
+
+  // the mapping moves with the object.
+  auto moved = std::move(*file);
+  EXPECT_EQ(moved.contents(), "P AND Q\nSAT P");
+  EXPECT_TRUE(file->contents().empty());
+  std::remove(path.c_str());
+}
+
+TEST(MappedFile, TestEmptyAndMissingFiles) {
+  const auto path = writeTemporary("");
+  auto empty = MappedFile::open(path);
+  ASSERT_TRUE(empty.has_value());
+  EXPECT_TRUE(empty->contents().empty());
+  std::remove(path.c_str());
+
+  EXPECT_FALSE(MappedFile::open("/nonexistent/source.pl").has_value());
+  EXPECT_FALSE(MappedFile::open("/tmp").has_value());
+}
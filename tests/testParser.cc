@@ -4,10 +4,12 @@
 #include <logic/parsing/scanner.h>
 #include <logic/parsing/token.h>
 #include <logic/parsing/parser.h>
+#include <logic/parsing/splitter.h>
 
 #include <logic/utils/macros.h>
 #include <logic/utils/overloaded.h>
 
+#include "tests/parse.h"
 #include "tests/printer.h"
 #include "tests/reporter.h"
 
@@ -106,3 +108,123 @@ TEST(Parser, TestImplicationAssociativity) {
   );
   verifySentence("P IMPLIES Q IMPLIES S", std::move(sentence));
 }
+
+TEST(Parser, TestQuerySentence) {
+  auto sentence = Sentence::Query(
+    Token(TokenType::Valid, DUMMY_LOCATION, "VALID"),
+    Sentence::Compound(
+      Token(TokenType::Or, DUMMY_LOCATION, "OR"),
+      Sentence::Variable(Token(TokenType::Variable, DUMMY_LOCATION, "P12")),
+      Sentence::Negated(Sentence::Variable(Token(TokenType::Variable, DUMMY_LOCATION, "P12")))
+    )
+  );
+
+  verifySentence("VALID P12 OR NOT P12", std::move(sentence));
+}
+
+TEST(Parser, TestShardsEndAtSentenceBoundaries) {
+  const auto source = std::string_view(
+    "P AND Q\n"
+    "R\n"
+    "OR S\n"
+    "# a comment (with an open parenthesis\n"
+    "(P\n"
+    "  IMPLIES Q)\n"
+    "NOT\n"
+    "P\n"
+    "SAT P AND\n"
+    "Q\n"
+    "Q = TRUE\n"
+    "P EQUIVALENT Q\n"
+  );
+
+  static constexpr auto parseAll = [](std::string_view source, size_t line) {
+    auto tokens = Scanner(source, "REPL", line).scan();
+    auto sentences = Parser(std::move(*tokens)).parse();
+    auto strings = std::vector<std::string>();
+    for (const auto& sentence : *sentences) strings.push_back(Sentence::asString(sentence));
+    return strings;
+  };
+
+  // a target of one byte cuts at every boundary it can.
+  const auto shards = splitShards(source, 1);
+  auto strings = std::vector<std::string>();
+  for (const auto& shard : shards) {
+    auto parsed = parseAll(shard.source, shard.line);
+    strings.insert(strings.end(), parsed.begin(), parsed.end());
+  }
+
+  EXPECT_EQ(shards.size(), 7);
+  EXPECT_EQ(shards[2].line, 4);
+  EXPECT_EQ(strings, parseAll(source, 1));
+}
+
+TEST(Parser, TestDeeplyNestedSentences) {
+  auto negated = std::string();
+  for (size_t i = 0; i < NESTING_DEPTH; i++) negated += "NOT ";
+  negated += "P";
+  const auto negations = parse(negated);
+  EXPECT_EQ(Sentence::asString(negations).size(), NESTING_DEPTH * std::string_view("¬").size() + 1);
+  EXPECT_EQ(negations.location().start, 4 * NESTING_DEPTH);
+
+  // NOTE: the tokens of a sentence point into its source, which has to outlive it.
+  const auto parenthesized = std::string(NESTING_DEPTH, '(') + "P" + std::string(NESTING_DEPTH, ')');
+  const auto grouped = parse(parenthesized);
+  EXPECT_EQ(Sentence::asString(grouped), parenthesized);
+
+  // connectives of the same precedence nest to the right, and tighter ones inside of them.
+  auto chain = std::string("P");
+  for (size_t i = 0; i < NESTING_DEPTH; i++) chain += i % 2 == 0 ? " IMPLIES Q" : " OR P";
+  const auto implications = parse(chain);
+  const auto* current = &implications;
+  for (size_t i = 0; i < 3; i++) {
+    ASSERT_TRUE(current->is<Sentence::Compound>());
+    current = current->unsafeAsRef<Sentence::Compound>().right.get();
+  }
+  EXPECT_EQ(implications.location(), SourceLocation(0, chain.size(), 1, "REPL"));
+  EXPECT_EQ(implications, parse(chain));
+  EXPECT_NE(implications, parse(chain + " AND P"));
+
+  auto nested = std::string(NESTING_DEPTH, '(') + "P";
+  for (size_t i = 0; i < NESTING_DEPTH; i++) nested += " AND Q)";
+  // NOTE: `∧` takes as many bytes as `AND`.
+  EXPECT_EQ(Sentence::asString(parse(nested)).size(), nested.size());
+}
+
+TEST(Parser, TestErrorRecovery) {
+  const auto source = std::string(
+    "P AND\n"
+    "  ) OR Q\n"
+    "R\n"
+    "(P OR Q\n"
+    "S AND T\n"
+    "P OR OR Q SAT P\n"
+    "NOT\n"
+  );
+
+  auto tokens = Scanner(source).scan();
+  ASSERT_TRUE(tokens.has_value());
+  auto parser = Parser(std::move(*tokens));
+  auto sentences = parser.parse();
+  ASSERT_FALSE(sentences.has_value());
+
+  // every error of the source is found in one pass, and the first one is returned.
+  const auto& errors = parser.errors();
+  ASSERT_EQ(errors.size(), 4);
+
+  const auto location = [](const ParserError& error) { return error.accept([](const auto& e) { return e.location; }); };
+  EXPECT_EQ(location(sentences.error()).line, 2);
+  EXPECT_EQ(location(errors[0]).line, 2);
+
+  // a sentence that is missing its `)` ends where the next one starts.
+  EXPECT_EQ(location(errors[1]).line, 5);
+  errors[1].accept(overloaded {
+    [](const ParserError::UnexpectedToken& e) { EXPECT_EQ(e.got.lexeme, "S"); },
+    [](const ParserError::ExpectedSentence&) { ADD_FAILURE(); },
+  });
+
+  // parsing resumes at a query keyword on the same line, and the last error is right after the last token.
+  EXPECT_EQ(location(errors[2]).line, 6);
+  EXPECT_EQ(location(errors[2]).start, 5);
+  EXPECT_EQ(location(errors[3]), SourceLocation(3, 4, 7, "REPL"));
+}
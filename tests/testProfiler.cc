@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "logic/utils/profiler.h"
+
+using namespace logic;
+
+static auto report() -> std::string {
+  char* buffer = nullptr;
+  size_t size = 0;
+  auto* file = open_memstream(&buffer, &size);
+  Profiler::report(file);
+  std::fclose(file);
+  auto text = std::string(buffer, size);
+  std::free(buffer);
+  return text;
+}
+
+TEST(Profiler, TestDisabledSpansAreNotMeasured) {
+  ASSERT_FALSE(Profiler::enabled());
+  report();
+
+  bool named = false;
+  {
+    auto span = Profiler::Span(Profiler::Phase::Evaluate);
+    span.rows(8);
+    span.name([&] { named = true; return std::string("P"); });
+  }
+  EXPECT_FALSE(named);
+  EXPECT_EQ(report().find("evaluate"), std::string::npos);
+}
+
+TEST(Profiler, TestStatisticsAndTrace) {
+  char* buffer = nullptr;
+  size_t size = 0;
+  auto* trace = open_memstream(&buffer, &size);
+
+  Profiler::start(true, trace);
+  {
+    auto sentence = Profiler::Span(Profiler::Phase::Sentence);
+    sentence.name([] { return std::string("P ∧ \"Q\""); });
+    for (size_t block = 0; block < 2; block++) {
+      auto span = Profiler::Span(Profiler::Phase::Evaluate);
+      span.rows(4);
+    }
+  }
+  Profiler::stop();
+  std::fclose(trace);
+
+  const auto text = std::string(buffer, size);
+  std::free(buffer);
+  EXPECT_TRUE(text.starts_with("{\"traceEvents\":["));
+  EXPECT_TRUE(text.ends_with("],\"displayTimeUnit\":\"ms\"}\n"));
+  EXPECT_NE(text.find("\"name\":\"evaluate\",\"cat\":\"evaluate\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(text.find("\"name\":\"P ∧ \\\"Q\\\"\",\"cat\":\"sentence\""), std::string::npos);
+
+  const auto statistics = report();
+  EXPECT_NE(statistics.find("sentence"), std::string::npos);
+  const auto evaluate = statistics.substr(statistics.find("evaluate"));
+  EXPECT_NE(evaluate.find(" 2 "), std::string::npos);
+  EXPECT_NE(evaluate.find(" 8 "), std::string::npos);
+
+  // the statistics are reset by every report.
+  EXPECT_EQ(report().find("evaluate"), std::string::npos);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "logic/evaluation/evaluator.h"
+#include "logic/evaluation/program.h"
+
+#include "tests/parse.h"
+#include "tests/printer.h"
+#include "tests/reporter.h"
+
+using namespace logic;
+
+TEST(Program, TestRegistersAreReused) {
+  auto sentence = parse("(A AND B) OR (C AND D) OR (E AND F) OR (A IMPLIES NOT B) OR (C EQUIVALENT D)");
+  auto environment = Environment();
+  auto evaluator = Evaluator(environment);
+
+  auto program = evaluator.compile(sentence, false);
+  if (not program.has_value()) {
+    FAIL() << report(program.error());
+  }
+
+  EXPECT_TRUE(program->outputs.empty());
+  EXPECT_LE(program->registers, 4);
+  EXPECT_GT(program->instructions.size(), program->registers);
+}
+
+TEST(Program, TestOutputsMatchTableColumns) {
+  auto sentence = parse("NOT P AND (Q OR P)");
+  auto environment = Environment();
+  auto evaluator = Evaluator(environment);
+
+  auto program = evaluator.compile(sentence);
+  if (not program.has_value()) {
+    FAIL() << report(program.error());
+  }
+
+  auto names = std::vector<std::string>();
+  for (const auto& output : program->outputs) {
+    names.push_back(output.name);
+  }
+  EXPECT_EQ(names, std::vector<std::string>({"P", "Q", "¬P", "Q ∨ P", "¬P ∧ (Q ∨ P)"}));
+}
+
+TEST(Program, TestRunOverBlocks) {
+  auto sentence = parse("(A OR B) AND (C IMPLIES D) AND (E EQUIVALENT NOT F) AND G");
+  auto environment = Environment();
+  auto evaluator = Evaluator(environment);
+
+  auto whole = Evaluator(environment).evaluate(sentence);
+  auto program = evaluator.compile(sentence, false);
+  if (not whole.has_value() or not program.has_value()) {
+    FAIL();
+  }
+
+  // the same program is run over several blocks which are stitched back together
+  auto machine = Machine();
+  auto stitched = Value(false, environment.totalRows());
+  for (size_t start = 0; start < environment.totalRows(); start += 24) {
+    auto rows = std::min<size_t>(24, environment.totalRows() - start);
+    machine.run(*program, environment, RowRange(start, rows));
+    for (size_t row = 0; row < rows; row++) {
+      stitched.set(start + row, machine.at(program->result).test(row));
+    }
+  }
+
+  EXPECT_EQ(stitched, *whole);
+}
+
+TEST(Program, TestCommonSubexpressionsAreEvaluatedOnce) {
+  auto sentence = parse("(A AND B) OR NOT (A AND B) OR ((A AND B) IMPLIES C)");
+  auto environment = Environment();
+  auto evaluator = Evaluator(environment);
+
+  auto program = evaluator.compile(sentence, false);
+  if (not program.has_value()) {
+    FAIL() << report(program.error());
+  }
+
+  auto conjunctions = std::ranges::count_if(program->instructions, [](const Instruction& instruction) {
+    return instruction.opcode == OpCode::Conjunction;
+  });
+  EXPECT_EQ(conjunctions, 1);
+
+  auto expected = Evaluator(environment).evaluate(sentence);
+  auto machine = Machine();
+  machine.run(*program, environment, RowRange(0, environment.totalRows()));
+  EXPECT_EQ(machine.at(program->result), *expected);
+}
+
+TEST(Program, TestShortCircuitMatchesFullEvaluation) {
+  // NOTE: `A` and `B` are the first variables, so their columns are constant over blocks of a few rows.
+  for (auto source : {"A AND ((C OR D) AND (E IMPLIES F) AND (G EQUIVALENT NOT C))",
+                      "((C AND D) OR (E EQUIVALENT F) OR NOT G) OR B",
+                      "A IMPLIES ((C OR D) AND (E IMPLIES NOT F))",
+                      "((C OR D) AND (E IMPLIES NOT F)) IMPLIES B"}) {
+    auto sentence = parse(source);
+    auto environment = Environment();
+    auto evaluator = Evaluator(environment);
+
+    auto whole = Evaluator(environment).evaluate(sentence);
+    auto program = evaluator.compile(sentence, false);
+    if (not whole.has_value() or not program.has_value()) {
+      FAIL() << source;
+    }
+    EXPECT_TRUE(std::ranges::any_of(program->instructions, [](const Instruction& instruction) {
+      return instruction.opcode == OpCode::ShortCircuit;
+    })) << source;
+
+    auto machine = Machine();
+    auto stitched = Value(false, environment.totalRows());
+    for (size_t start = 0; start < environment.totalRows(); start += 24) {
+      auto rows = std::min<size_t>(24, environment.totalRows() - start);
+      machine.run(*program, environment, RowRange(start, rows));
+      for (size_t row = 0; row < rows; row++) {
+        stitched.set(start + row, machine.at(program->result).test(row));
+      }
+    }
+    EXPECT_EQ(stitched, *whole) << source;
+  }
+
+  // a sub-sentence repeated inside the consequent is read twice, so the consequent is not skipped.
+  auto environment = Environment();
+  auto program = Evaluator(environment).compile(parse("A IMPLIES ((C OR D) AND (E EQUIVALENT (C OR D)))"), false);
+  ASSERT_TRUE(program.has_value());
+  EXPECT_TRUE(std::ranges::none_of(program->instructions, [](const Instruction& instruction) {
+    return instruction.opcode == OpCode::ShortCircuit and not instruction.decisive and instruction.decision;
+  }));
+
+  EXPECT_TRUE(Value(true, 70).all(true));
+  EXPECT_FALSE(Value({true, true, false}).all(true));
+  EXPECT_TRUE(Value(false, 130).all(false));
+}
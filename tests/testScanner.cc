@@ -73,3 +73,97 @@ TEST(Scanner, TestSkipComments) {
     EXPECT_EQ(token.type, expectedType) << token.lexeme;
   }
 }
+
+TEST(Scanner, TestQueriesAndNumberedVariables) {
+
+  auto scanner = Scanner("SAT VALID COUNT P1 Q23 R");
+  auto tokens = scanner.scan();
+
+  if (not tokens.has_value()) {
+    FAIL() << report(tokens.error());
+  }
+
+  auto expectedTokens = std::initializer_list<TokenType> {
+    TokenType::Sat,
+    TokenType::Valid,
+    TokenType::Count,
+    TokenType::Variable,
+    TokenType::Variable,
+    TokenType::Variable,
+    TokenType::EndOfFile,
+  };
+
+  EXPECT_EQ(tokens->size(), expectedTokens.size());
+  for (const auto& [token, expectedType] : std::views::zip(*tokens, expectedTokens)) {
+    EXPECT_EQ(token.type, expectedType) << token.lexeme;
+  }
+  EXPECT_EQ(tokens->at(4).lexeme, "Q23");
+
+  auto invalid = Scanner("P1A AND Q").scan();
+  ASSERT_FALSE(invalid.has_value());
+  invalid.error().accept(overloaded {
+    [](const ScannerError::InvalidVariableName& e) { EXPECT_EQ(e.name, "P1A"); },
+    [](const auto&) { FAIL() << "expected an invalid variable name"; },
+  });
+}
+
+TEST(Scanner, TestLongBlankRunsKeepLocations) {
+
+  auto source = std::string("\t") + std::string(40, ' ') + "P AND\r\n" + std::string(17, ' ') + "Q # comment\n\n   R";
+  auto scanner = Scanner(source);
+  auto tokens = scanner.scan();
+
+  if (not tokens.has_value()) {
+    FAIL() << report(tokens.error());
+  }
+
+  ASSERT_EQ(tokens->size(), 5);
+  EXPECT_EQ(tokens->at(0).location, SourceLocation(41, 42, 1, "REPL"));
+  EXPECT_EQ(tokens->at(1).location, SourceLocation(43, 46, 1, "REPL"));
+  EXPECT_EQ(tokens->at(2).location, SourceLocation(17, 18, 2, "REPL"));
+  EXPECT_EQ(tokens->at(3).location, SourceLocation(3, 4, 4, "REPL"));
+  EXPECT_EQ(tokens->at(4).type, TokenType::EndOfFile);
+}
+
+TEST(Scanner, TestKeywordErrors) {
+
+  auto error = [](std::string_view source) {
+    auto tokens = Scanner(source).scan();
+    EXPECT_FALSE(tokens.has_value()) << source;
+    return tokens.error();
+  };
+
+  error("P and Q").accept(overloaded {
+    [](const ScannerError::InvalidKeywordFormat& e) { EXPECT_EQ(e.keyword, "and"); },
+    [](const auto&) { FAIL() << "expected an invalid keyword format"; },
+  });
+
+  error("P IMPLIE Q").accept(overloaded {
+    [](const ScannerError::UnexpectedKeyword& e) {
+      EXPECT_EQ(e.keyword, "IMPLIE");
+      EXPECT_EQ(e.suggestion, "IMPLIES");
+    },
+    [](const auto&) { FAIL() << "expected an unexpected keyword"; },
+  });
+}
+
+TEST(Scanner, TestErrorRecovery) {
+
+  auto scanner = Scanner("P AND >\nQ OR\nR $ S\nP IMPLIE Q\n");
+  auto tokens = scanner.scan();
+  ASSERT_FALSE(tokens.has_value());
+
+  // every line with an error is reported, and left out of the tokens.
+  const auto& errors = scanner.errors();
+  ASSERT_EQ(errors.size(), 3);
+  const auto line = [](const ScannerError& error) { return error.accept([](const auto& e) { return e.location.line; }); };
+  EXPECT_EQ(line(errors[0]), 1);
+  EXPECT_EQ(line(errors[1]), 3);
+  EXPECT_EQ(line(errors[2]), 4);
+
+  const auto& scanned = scanner.tokens();
+  ASSERT_EQ(scanned.size(), 3);
+  EXPECT_EQ(scanned[0].lexeme, "Q");
+  EXPECT_EQ(scanned[1].type, TokenType::Or);
+  EXPECT_EQ(scanned[2].location, SourceLocation(4, 5, 2, "REPL"));
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "logic/evaluation/evaluator.h"
+#include "logic/parsing/simplifier.h"
+
+#include "tests/parse.h"
+#include "tests/reporter.h"
+
+using namespace logic;
+
+static auto simplify(std::string_view source) -> std::string {
+  return Sentence::asString(Simplifier::simplify(parse(source)));
+}
+
+// Checks that the simplified sentence has the same column as the original one over its variables.
+static auto verifyEquivalent(std::string_view source) -> void {
+  const auto original = parse(source);
+  const auto simplified = Simplifier::simplify(original);
+
+  auto environment = Environment();
+  auto expected = Evaluator(environment).evaluate(original);
+  ASSERT_TRUE(expected.has_value());
+
+  auto evaluator = Evaluator(environment);
+  ASSERT_TRUE(evaluator.declare(original).has_value());
+  auto got = evaluator.evaluate(simplified);
+  ASSERT_TRUE(got.has_value());
+  EXPECT_EQ(*expected, *got) << source << " simplified to " << Sentence::asString(simplified);
+}
+
+TEST(Simplifier, TestConstantsAndNegations) {
+  EXPECT_EQ(simplify("P AND TRUE"), "P");
+  EXPECT_EQ(simplify("P AND FALSE"), "FALSE");
+  EXPECT_EQ(simplify("P OR TRUE"), "TRUE");
+  EXPECT_EQ(simplify("FALSE OR P"), "P");
+  EXPECT_EQ(simplify("NOT NOT P"), "P");
+  EXPECT_EQ(simplify("NOT NOT NOT P"), "¬P");
+  EXPECT_EQ(simplify("NOT TRUE"), "FALSE");
+  EXPECT_EQ(simplify("NOT (NOT (P AND Q))"), "P ∧ Q");
+  EXPECT_EQ(simplify("TRUE IMPLIES P"), "P");
+  EXPECT_EQ(simplify("P IMPLIES FALSE"), "¬P");
+  EXPECT_EQ(simplify("(P OR Q) IMPLIES FALSE"), "¬(P ∨ Q)");
+  EXPECT_EQ(simplify("P EQUIVALENT FALSE"), "¬P");
+  EXPECT_EQ(simplify("P EQUIVALENT TRUE"), "P");
+}
+
+TEST(Simplifier, TestChains) {
+  // idempotence, also across a chain and through parentheses.
+  EXPECT_EQ(simplify("P AND P"), "P");
+  EXPECT_EQ(simplify("P AND Q AND (P AND R)"), "P ∧ (Q ∧ R)");
+  EXPECT_EQ(simplify("P AND NOT NOT P"), "P");
+
+  // complements.
+  EXPECT_EQ(simplify("P OR NOT P"), "TRUE");
+  EXPECT_EQ(simplify("Q AND P AND NOT P"), "FALSE");
+  EXPECT_EQ(simplify("(P AND Q) OR NOT (P AND Q)"), "TRUE");
+  EXPECT_EQ(simplify("P EQUIVALENT NOT P"), "FALSE");
+  EXPECT_EQ(simplify("P IMPLIES P"), "TRUE");
+
+  // absorption.
+  EXPECT_EQ(simplify("P AND (P OR Q)"), "P");
+  EXPECT_EQ(simplify("(Q OR R OR P) AND S AND P"), "S ∧ P");
+  EXPECT_EQ(simplify("P OR (Q AND P)"), "P");
+
+  // parentheses are only kept under a negation.
+  EXPECT_EQ(simplify("((P))"), "P");
+  EXPECT_EQ(simplify("(P OR Q) AND R"), "(P ∨ Q) ∧ R");
+  EXPECT_EQ(simplify("NOT ((P OR Q))"), "¬(P ∨ Q)");
+}
+
+TEST(Simplifier, TestFixpointAndEquivalence) {
+  // the chain only collapses once its operands are simplified.
+  EXPECT_EQ(simplify("(P AND TRUE) OR (NOT NOT P AND Q) OR FALSE"), "P");
+
+  for (auto source : {"P AND (Q OR NOT Q) AND (R OR (R AND S))", "(P IMPLIES Q) EQUIVALENT (NOT Q IMPLIES NOT P)",
+                      "NOT (P AND NOT P) OR Q", "(A OR B) AND (NOT A OR C) AND (A OR B)", "P IMPLIES NOT P"}) {
+    verifyEquivalent(source);
+  }
+}
+
+TEST(Simplifier, TestSentencesThatAreKept) {
+  EXPECT_FALSE(Simplifier::isSimplifiable(parse("A = TRUE")));
+  EXPECT_FALSE(Simplifier::isSimplifiable(parse("COUNT P OR NOT P")));
+  EXPECT_TRUE(Simplifier::isSimplifiable(parse("SAT P OR NOT P")));
+
+  EXPECT_EQ(simplify("VALID P OR NOT P"), "VALID TRUE");
+  EXPECT_EQ(simplify("COUNT P AND TRUE"), "COUNT P ∧ TRUE");
+  EXPECT_EQ(Simplifier::size(parse("NOT (P AND Q)")), 4);
+}
+
+TEST(Simplifier, TestDeeplyNestedSentences) {
+  auto source = std::string();
+  for (size_t i = 0; i < NESTING_DEPTH; i++) source += "NOT (";
+  source += "P AND P";
+  source += std::string(NESTING_DEPTH, ')');
+  EXPECT_EQ(simplify(source), "P");
+}
+
+TEST(Simplifier, TestDeeplyNestedImplications) {
+  // NOTE: every implication folds to `TRUE` from the right, which takes the span of the whole sentence.
+  auto source = std::string();
+  for (size_t i = 0; i < NESTING_DEPTH; i++) source += "P IMPLIES ";
+  source += "TRUE";
+
+  const auto simplified = Simplifier::simplify(parse(source));
+  EXPECT_EQ(Sentence::asString(simplified), "TRUE");
+  EXPECT_EQ(simplified.location(), SourceLocation(0, source.size(), 1, "REPL"));
+}
+
+TEST(Simplifier, TestDeeplyNestedChains) {
+  // NOTE: every chain has a chain of the dual connective as its operand, none of them can be simplified.
+  auto source = std::string();
+  for (size_t i = 0; i < NESTING_DEPTH; i++) source += i % 2 == 0 ? "P AND (" : "Q OR (";
+  source += "R";
+  source += std::string(NESTING_DEPTH, ')');
+
+  const auto original = parse(source);
+  EXPECT_EQ(Simplifier::size(Simplifier::simplify(original)), Simplifier::size(original));
+}
@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "logic/solver/cnf.h"
+#include "logic/solver/dimacs.h"
+#include "logic/solver/prover.h"
+#include "logic/solver/solver.h"
+
+#include "tests/parse.h"
+#include "tests/reporter.h"
+
+using namespace logic;
+
+static auto isSatisfiedBy(const Cnf& cnf, auto&& value) -> bool {
+  for (size_t i = 0; i < cnf.clauses(); i++) {
+    bool satisfied = false;
+    for (auto literal : cnf.clause(i)) {
+      satisfied = satisfied or value(literal.variable()) != literal.isNegated();
+    }
+    if (not satisfied) return false;
+  }
+  return true;
+}
+
+// Evaluates every node of the table up to `root` under an assignment of its variables.
+static auto evaluate(const NodeTable& nodes, NodeId root, auto&& value) -> bool {
+  auto values = std::vector<bool>(root + 1);
+  for (NodeId id = 0; id <= root; id++) {
+    const auto& node = nodes[id];
+    if (node.kind == Node::Kind::Variable) {
+      values[id] = value(node.left);
+      continue;
+    }
+    if (node.kind == Node::Kind::Constant) {
+      values[id] = node.left;
+      continue;
+    }
+    const bool a = values[node.left];
+    const bool b = node.isBinary() and values[node.right];
+    switch (node.kind) {
+      case Node::Kind::Negation: values[id] = not a; break;
+      case Node::Kind::Conjunction: values[id] = a and b; break;
+      case Node::Kind::Disjunction: values[id] = a or b; break;
+      case Node::Kind::Implication: values[id] = not a or b; break;
+      case Node::Kind::Bijection: values[id] = a == b; break;
+      default: break;
+    }
+  }
+  return values[root];
+}
+
+static auto prove(std::string_view source, const Environment& environment = Environment()) -> Answer {
+  auto sentence = parse(source);
+  auto prover = Prover(environment);
+  return *prover.prove(sentence.unsafeAsRef<Sentence::Query>());
+}
+
+TEST(Solver, TestRandomFormulasAgainstEnumeration) {
+  auto generator = std::mt19937(1234);
+
+  for (int round = 0; round < 300; round++) {
+    const uint32_t variables = 3 + generator() % 10;
+    const size_t clauses = variables * (2 + generator() % 4);
+
+    auto cnf = Cnf();
+    for (uint32_t i = 0; i < variables; i++) cnf.newVariable();
+    for (size_t i = 0; i < clauses; i++) {
+      auto clause = std::vector<Literal>();
+      for (int k = 0; k < 3; k++) {
+        const auto variable = uint32_t(generator() % variables);
+        clause.push_back(generator() % 2 ? Literal::positive(variable) : Literal::negative(variable));
+      }
+      cnf.addClause(clause);
+    }
+
+    bool expected = false;
+    for (uint32_t assignment = 0; assignment < (1u << variables) and not expected; assignment++) {
+      expected = isSatisfiedBy(cnf, [&](uint32_t variable) { return (assignment >> variable) & 1; });
+    }
+
+    auto solver = Solver(cnf);
+    const auto satisfiable = solver.solve() == Solver::Result::Satisfiable;
+    EXPECT_EQ(satisfiable, expected) << "round " << round;
+    if (satisfiable) {
+      EXPECT_TRUE(isSatisfiedBy(cnf, [&](uint32_t variable) { return solver.value(variable); }));
+    }
+  }
+}
+
+TEST(Solver, TestPigeonholeIsUnsatisfiable) {
+  // 7 pigeons do not fit in 6 holes, a classic instance that needs many conflicts.
+  constexpr uint32_t pigeons = 7, holes = 6;
+  auto cnf = Cnf();
+  auto in = [](uint32_t pigeon, uint32_t hole) { return pigeon * holes + hole; };
+  for (uint32_t i = 0; i < pigeons * holes; i++) cnf.newVariable();
+
+  for (uint32_t pigeon = 0; pigeon < pigeons; pigeon++) {
+    auto clause = std::vector<Literal>();
+    for (uint32_t hole = 0; hole < holes; hole++) clause.push_back(Literal::positive(in(pigeon, hole)));
+    cnf.addClause(clause);
+  }
+  for (uint32_t hole = 0; hole < holes; hole++) {
+    for (uint32_t a = 0; a < pigeons; a++) {
+      for (uint32_t b = a + 1; b < pigeons; b++) {
+        cnf.addClause({Literal::negative(in(a, hole)), Literal::negative(in(b, hole))});
+      }
+    }
+  }
+
+  auto solver = Solver(cnf);
+  EXPECT_EQ(solver.solve(), Solver::Result::Unsatisfiable);
+  EXPECT_GT(solver.statistics().conflicts, 0);
+}
+
+TEST(Solver, TestAssumptions) {
+  auto cnf = Cnf();
+  const auto p = cnf.newVariable();
+  const auto q = cnf.newVariable();
+  cnf.addClause({Literal::negative(p), Literal::positive(q)});
+
+  auto solver = Solver(cnf);
+  const auto both = std::vector<Literal>{Literal::positive(p), Literal::negative(q)};
+  EXPECT_EQ(solver.solve(both), Solver::Result::Unsatisfiable);
+
+  const auto one = std::vector<Literal>{Literal::positive(p)};
+  EXPECT_EQ(solver.solve(one), Solver::Result::Satisfiable);
+  EXPECT_TRUE(solver.value(q));
+}
+
+TEST(Solver, TestPrunedEncodingIsEquisatisfiable) {
+  static constexpr std::string_view names[] = {"A", "B", "C", "D", "E"};
+  static constexpr Node::Kind connectives[] = {
+    Node::Kind::Conjunction, Node::Kind::Disjunction, Node::Kind::Implication, Node::Kind::Bijection,
+  };
+  auto generator = std::mt19937(99);
+
+  for (int round = 0; round < 300; round++) {
+    auto nodes = NodeTable();
+    auto pool = std::vector<NodeId>();
+    for (auto name : names) pool.push_back(nodes.variable(name));
+    for (int i = 0; i < 12; i++) {
+      const auto left = pool[generator() % pool.size()];
+      const auto right = pool[generator() % pool.size()];
+      const auto node = generator() % 5 == 0
+        ? nodes.negation(left)
+        : nodes.binary(connectives[generator() % 4], left, right);
+      pool.push_back(node);
+    }
+    const auto root = pool.back();
+
+    bool satisfiable = false, valid = true;
+    for (uint32_t assignment = 0; assignment < (1u << nodes.variables().size()); assignment++) {
+      const auto value = evaluate(nodes, root, [&](uint32_t variable) { return (assignment >> variable) & 1; });
+      satisfiable = satisfiable or value;
+      valid = valid and value;
+    }
+
+    for (auto polarity : {Tseitin::Polarity::Positive, Tseitin::Polarity::Negative}) {
+      auto full = Cnf(), pruned = Cnf();
+      Tseitin::encode(nodes, root, Tseitin::Polarity::Both, full);
+      const auto encoding = Tseitin::encode(nodes, root, polarity, pruned);
+      EXPECT_LE(pruned.clauses(), full.clauses());
+
+      const auto isPositive = polarity == Tseitin::Polarity::Positive;
+      pruned.addClause({isPositive ? encoding.root : ~encoding.root});
+      auto solver = Solver(pruned);
+      const auto result = solver.solve() == Solver::Result::Satisfiable;
+      EXPECT_EQ(result, isPositive ? satisfiable : not valid) << "round " << round;
+
+      // NOTE: the pruned encoding still forces the root, so its models are models of the sentence.
+      if (result) {
+        const auto value = evaluate(nodes, root, [&](uint32_t variable) { return solver.value(encoding.inputs[variable]); });
+        EXPECT_EQ(value, isPositive) << "round " << round;
+      }
+    }
+  }
+}
+
+TEST(Solver, TestDimacsExport) {
+  auto sentence = parse("VALID (P AND Q) IMPLIES (P OR R)");
+  auto environment = Environment();
+
+  auto* file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+  ASSERT_TRUE(Prover(environment).exportDimacs(sentence.unsafeAsRef<Sentence::Query>(), file).has_value());
+
+  std::string output;
+  std::rewind(file);
+  for (int c; (c = std::fgetc(file)) != EOF;) output += char(c);
+  std::fclose(file);
+
+  auto lines = std::istringstream(output);
+  auto line = std::string();
+  size_t variables = 0, clauses = 0, inputs = 0, written = 0;
+  auto cnf = Cnf();
+  while (std::getline(lines, line)) {
+    if (line.starts_with("c input")) inputs++;
+    if (line.starts_with("p cnf")) std::sscanf(line.c_str(), "p cnf %zu %zu", &variables, &clauses);
+    if (line.starts_with("c") or line.starts_with("p")) continue;
+
+    auto clause = std::vector<Literal>();
+    auto numbers = std::istringstream(line);
+    for (long number; numbers >> number and number != 0;) {
+      EXPECT_LE(size_t(std::abs(number)), variables);
+      while (cnf.variables() < uint32_t(std::abs(number))) cnf.newVariable();
+      const auto variable = uint32_t(std::abs(number) - 1);
+      clause.push_back(number > 0 ? Literal::positive(variable) : Literal::negative(variable));
+    }
+    cnf.addClause(clause);
+    written++;
+  }
+
+  EXPECT_TRUE(output.starts_with("c VALID"));
+  EXPECT_EQ(inputs, 3);
+  EXPECT_EQ(written, clauses);
+  // the sentence is valid, so the exported negation is unsatisfiable.
+  while (cnf.variables() < variables) cnf.newVariable();
+  EXPECT_EQ(Solver(cnf).solve(), Solver::Result::Unsatisfiable);
+}
+
+TEST(Prover, TestQueries) {
+  EXPECT_FALSE(prove("SAT P AND NOT P").holds);
+  EXPECT_TRUE(prove("SAT P AND Q").holds);
+  EXPECT_TRUE(prove("VALID P OR NOT P").holds);
+  EXPECT_TRUE(prove("VALID NOT (P AND Q) EQUIVALENT (NOT P OR NOT Q)").holds);
+  EXPECT_TRUE(prove("VALID ((P IMPLIES Q) AND (Q IMPLIES R)) IMPLIES (P IMPLIES R)").holds);
+  EXPECT_TRUE(prove("SAT TRUE").holds);
+  EXPECT_FALSE(prove("SAT FALSE").holds);
+
+  auto answer = prove("VALID P IMPLIES Q");
+  EXPECT_FALSE(answer.holds);
+  using Witness = std::vector<std::pair<std::string_view, bool>>;
+  EXPECT_EQ(answer.witness, Witness({{"P", true}, {"Q", false}}));
+}
+
+TEST(Prover, TestAssignedVariablesAreConstants) {
+  auto environment = Environment();
+  environment.assign("Q", false);
+  EXPECT_TRUE(prove("VALID Q IMPLIES R", environment).holds);
+  EXPECT_FALSE(prove("SAT Q", environment).holds);
+}
+
+TEST(Prover, TestHundredsOfVariables) {
+  // X0 => X1 => ... => X299 chained with AND, valid to conclude X299 from X0.
+  std::string chain;
+  for (int i = 0; i < 299; i++) {
+    if (not chain.empty()) chain += " AND ";
+    chain += fmt::format("(X{} IMPLIES X{})", i, i + 1);
+  }
+  EXPECT_TRUE(prove(fmt::format("VALID ({}) AND X0 IMPLIES X299", chain)).holds);
+  EXPECT_FALSE(prove(fmt::format("VALID ({}) IMPLIES X299", chain)).holds);
+}
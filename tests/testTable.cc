@@ -0,0 +1,51 @@
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "logic/evaluation/value.h"
+#include "logic/utils/color.h"
+#include "logic/utils/table.h"
+
+using namespace logic;
+
+TEST(StreamingTable, TestRendersRows) {
+  const auto line = fmt::format("{}", Color::Gray("|"));
+  const auto table = StreamingTable({"P", "PQ"});
+
+  auto p = Value({true, false, true});
+  auto q = Value({false, false, true});
+  std::string buffer = "prefix";
+  table.renderRows({&p, &q}, 1, 2, buffer);
+
+  const auto expected = "prefix"
+    + line + " F " + line + " F  " + line + "\n"
+    + line + " T " + line + " T  " + line + "\n";
+  EXPECT_EQ(buffer, expected);
+}
+
+TEST(StreamingTable, TestMachineReadableFormats) {
+  auto p = Value({true, false, true});
+  auto q = Value({false, false, true});
+
+  std::string csv;
+  StreamingTable({"P", "Q"}, StreamingTable::Format::Csv).renderRows({&p, &q}, 0, 3, csv);
+  EXPECT_EQ(csv, "T,F\nF,F\nT,T\n");
+
+  std::string jsonl;
+  StreamingTable({"P", "Q"}, StreamingTable::Format::Jsonl).renderRows({&p, &q}, 1, 2, jsonl);
+  EXPECT_EQ(jsonl, "{\"P\":false,\"Q\":false}\n{\"P\":true,\"Q\":true}\n");
+
+  // 70 rows take two words per column, interleaved by column.
+  auto all = Value(true, 70);
+  auto none = Value(false, 70);
+  std::string bin;
+  StreamingTable({"A", "B"}, StreamingTable::Format::Bin).renderRows({&all, &none}, 0, 70, bin);
+  ASSERT_EQ(bin.size(), 4 * sizeof(Value::Word));
+
+  Value::Word words[4];
+  std::memcpy(words, bin.data(), bin.size());
+  EXPECT_EQ(words[0], ~Value::Word(0));
+  EXPECT_EQ(words[1], 0);
+  EXPECT_EQ(words[2], (Value::Word(1) << 6) - 1);
+  EXPECT_EQ(words[3], 0);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "logic/utils/threadPool.h"
+
+using namespace logic;
+
+TEST(ThreadPool, TestRunsEveryTask) {
+  auto pool = ThreadPool(4);
+  auto counter = std::atomic<size_t>(0);
+
+  for (auto i = 0; i < 1000; i++) {
+    pool.submit([&counter] { counter += 1; });
+  }
+  pool.wait();
+
+  EXPECT_EQ(counter, 1000);
+}
+
+TEST(ThreadPool, TestUnevenTasksAreStolen) {
+  auto pool = ThreadPool(4);
+  auto results = std::vector<size_t>(64, 0);
+
+  // NOTE: tasks are handed out round-robin, so the heavy ones all land on the same queue and
+  //       only finish in reasonable time if the other workers steal from it.
+  for (size_t i = 0; i < results.size(); i++) {
+    pool.submit([&results, i] {
+      size_t sum = 0;
+      const size_t iterations = i % 4 == 0 ? 200000 : 10;
+      for (size_t j = 0; j < iterations; j++) sum += j;
+      results[i] = sum;
+    });
+  }
+  pool.wait();
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const size_t iterations = i % 4 == 0 ? 200000 : 10;
+    EXPECT_EQ(results[i], iterations * (iterations - 1) / 2);
+  }
+}
+
+TEST(ThreadPool, TestTasksRunInSubmissionOrder) {
+  auto pool = ThreadPool(1);
+  auto order = std::vector<size_t>();
+  auto started = std::atomic<bool>(false);
+  auto release = std::atomic<bool>(false);
+
+  // NOTE: the worker is held up by the first task until every other one is queued behind it.
+  pool.submit([&] {
+    started = true;
+    started.notify_one();
+    release.wait(false);
+  });
+  started.wait(false);
+  for (size_t i = 0; i < 8; i++) {
+    pool.submit([&order, i] { order.push_back(i); });
+  }
+  release = true;
+  release.notify_one();
+  pool.wait();
+
+  EXPECT_EQ(order, std::vector<size_t>({0, 1, 2, 3, 4, 5, 6, 7}));
+}